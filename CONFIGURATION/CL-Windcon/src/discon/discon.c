@@ -19,78 +19,89 @@ along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
 
 #define NINT(a) ((a) >= 0.0 ? (int) ((a)+0.5) : ((a)-0.5))
 
-#include "ikClwindconInputMod.h"
-#include "ikClwindconWTConfig.h"
+#include "ikClwindconTurbine.h"
 #include "OpenDiscon_EXPORT.h"
-#include <stdio.h>
+#include <string.h>
 
-void OpenDiscon_EXPORT DISCON(float *DATA, int FLAG, const char *INFILE, const char *OUTNAME, char *MESSAGE) {
+/* flush denormals to zero while the controller runs, where SSE is available */
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FTZ_DAZ_BITS 0x8040u /* flush to zero (bit 15) and denormals are zero (bit 6) */
+#define ENTER_FTZ_DAZ(csr) do { (csr) = _mm_getcsr(); _mm_setcsr((csr) | FTZ_DAZ_BITS); } while (0)
+#define LEAVE_FTZ_DAZ(csr) _mm_setcsr(csr)
+#else
+#define ENTER_FTZ_DAZ(csr) ((void) (csr))
+#define LEAVE_FTZ_DAZ(csr) ((void) (csr))
+#endif
+
+/* report to the simulator, which should stop on an error (negative flag) but carry on after a warning (positive flag) */
+static void setMessage(const float *DATA, int *FLAG, char *MESSAGE, int flag, const char *text) {
+	int n = NINT(DATA[48]); /* maximum number of characters in MESSAGE */
+	
+	if (NULL != FLAG) *FLAG = flag;
+	if (0 >= n) return;
+	strncpy(MESSAGE, text, n - 1);
+	MESSAGE[n - 1] = '\0';
+}
+
+void OpenDiscon_EXPORT DISCON(float *DATA, int *FLAG, const char *INFILE, const char *OUTNAME, char *MESSAGE) {
+	static ikClwindconTurbine turbine;
+	static int failed = 0;
+	unsigned int csr = 0;
+	char inFile[1024];
+	int n;
 	int err;
-	static ikClwindconWTCon con;
-	double output = -12.0;
-	static FILE *f = NULL;
-	const double deratingRatio = 0.2; /* later to be got via the supercontroller interface */
+	
+	/* decaying filter states would otherwise become denormal and slow */
+	ENTER_FTZ_DAZ(csr);
 		
 	if (NINT(DATA[0]) == 0) {
-		ikClwindconWTConParams param;
-		ikClwindconWTCon_initParams(&param);
-		setParams(&param);
-		ikClwindconWTCon_init(&con, &param);
-		f = fopen("log.bin", "wb");
+		/* in case the previous simulation did not end with a last call */
+		ikClwindconTurbine_close(&turbine);
+		n = NINT(DATA[49]); /* number of characters in INFILE */
+		n = 0 < n && n < (int) sizeof(inFile) ? n : (int) sizeof(inFile) - 1;
+		strncpy(inFile, INFILE, n);
+		inFile[n] = '\0';
+		/* tune for the communication interval, if the simulator gives one */
+		err = ikClwindconTurbine_init(&turbine, (double) DATA[2], inFile, "", -1); /* s */
+		failed = 1;
+		switch (err) {
+			case -1 :
+				setMessage(DATA, FLAG, MESSAGE, -1, "OpenDiscon controller could not be initialised");
+				break;
+			case -2 :
+				setMessage(DATA, FLAG, MESSAGE, -1, "OpenDiscon log or statistics file could not be opened");
+				break;
+			case -7 :
+				setMessage(DATA, FLAG, MESSAGE, -1, "OpenDiscon avrSWAP map in the controller parameter file is invalid");
+				break;
+			default :
+				if (ikClwindconTurbine_checkSwapSize(&turbine, DATA)) {
+					setMessage(DATA, FLAG, MESSAGE, -1, "OpenDiscon avrSWAP map uses records at or beyond the logging outputs given by record 63");
+					break;
+				}
+				failed = 0;
+				/* the monitors are not needed to control the turbine */
+				if (-3 == err) setMessage(DATA, FLAG, MESSAGE, 1, "OpenDiscon telemetry board could not be created");
+				else if (-4 == err) setMessage(DATA, FLAG, MESSAGE, 1, "OpenDiscon fatigue load monitor could not be initialised");
+				else if (-5 == err) setMessage(DATA, FLAG, MESSAGE, 1, "OpenDiscon windowed statistics could not be initialised");
+				else if (-6 == err) setMessage(DATA, FLAG, MESSAGE, 1, "OpenDiscon rotor harmonic monitors could not be initialised");
+		}
+		if (failed) ikClwindconTurbine_close(&turbine);
 	}
-
-	con.in.deratingRatio = deratingRatio;
-	con.in.externalMaximumTorque = 230.0; /* kNm */
-	con.in.externalMinimumTorque = 0.0; /* kNm */
-	con.in.externalMaximumPitch = 90.0; /* deg */
-	con.in.externalMinimumPitch = 0.0; /* deg */
-	con.in.generatorSpeed = (double) DATA[19]; /* rad/s */
-	con.in.rotorSpeed = (double) DATA[20]; /* rad/s */
-	con.in.maximumSpeed = 480.0/30*3.1416; /* rpm to rad/s */
-	con.in.azimuth = 180.0/3.1416 * (double) DATA[59]; /* rad to deg */
-	con.in.maximumIndividualPitch = 10.0; /* deg */
-	con.in.yawErrorReference = 0.0; /* deg */
-	con.in.yawError = 180.0/3.1416 * (double) DATA[23]; /* rad to deg */
-	con.in.bladeRootMoments[0].c[0] = 1.0e-3 * (double) DATA[68]; /* Nm to kNm */
-	con.in.bladeRootMoments[0].c[1] = 1.0e-3 * (double) DATA[29]; /* Nm to kNm */
-	con.in.bladeRootMoments[0].c[2] = 0.0; /* kNm */
-	con.in.bladeRootMoments[1].c[0] = 1.0e-3 * (double) DATA[69]; /* Nm to kNm */
-	con.in.bladeRootMoments[1].c[1] = 1.0e-3 * (double) DATA[30]; /* Nm to kNm */
-	con.in.bladeRootMoments[1].c[2] = 0.0; /* kNm */
-	con.in.bladeRootMoments[2].c[0] = 1.0e-3 * (double) DATA[70]; /* Nm to kNm */
-	con.in.bladeRootMoments[2].c[1] = 1.0e-3 * (double) DATA[31]; /* Nm to kNm */
-	con.in.bladeRootMoments[2].c[2] = 0.0; /* kNm */
 	
-	ikClwindconInputMod(&(con.in));
-	ikClwindconWTCon_step(&con);
+	/* never step a controller which is not fully set up */
+	if (failed) {
+		LEAVE_FTZ_DAZ(csr);
+		return;
+	}
 	
-	DATA[46] = (float) (con.out.torqueDemand*1.0e3); /* kNm to Nm */
-	DATA[41] = (float) (con.out.pitchDemandBlade1/180.0*3.1416); /* deg to rad */
-	DATA[42] = (float) (con.out.pitchDemandBlade2/180.0*3.1416); /* deg to rad */
-	DATA[43] = (float) (con.out.pitchDemandBlade3/180.0*3.1416); /* deg to rad */
-	err = ikClwindconWTCon_getOutput(&con, &output, "collective pitch demand");
-	DATA[44] = (float) (output/180.0*3.1416); /* deg to rad (collective pitch angle) */
-
-	err = ikClwindconWTCon_getOutput(&con, &output, "individual pitch control>pitch y from control");
-	fwrite(&(output), 1, sizeof(output), f);
-	err = ikClwindconWTCon_getOutput(&con, &output, "individual pitch control>pitch z from control");
-	fwrite(&(output), 1, sizeof(output), f);
-	err = ikClwindconWTCon_getOutput(&con, &output, "individual pitch control>My");
-	fwrite(&(output), 1, sizeof(output), f);
-	err = ikClwindconWTCon_getOutput(&con, &output, "individual pitch control>Mz");
-	fwrite(&(output), 1, sizeof(output), f);
-	err = ikClwindconWTCon_getOutput(&con, &output, "individual pitch control>pitch increment 1");
-	fwrite(&(output), 1, sizeof(output), f);
-	err = ikClwindconWTCon_getOutput(&con, &output, "individual pitch control>pitch increment 2");
-	fwrite(&(output), 1, sizeof(output), f);
-	err = ikClwindconWTCon_getOutput(&con, &output, "individual pitch control>pitch increment 3");
-	fwrite(&(output), 1, sizeof(output), f);
-	err = ikClwindconWTCon_getOutput(&con, &output, "generator speed equivalent");
-	fwrite(&(output), 1, sizeof(output), f);
-	err = ikClwindconWTCon_getOutput(&con, &output, "speed sensor manager>signal 1");
-	fwrite(&(output), 1, sizeof(output), f);
-	err = ikClwindconWTCon_getOutput(&con, &output, "speed sensor manager>signal 2");
-	fwrite(&(output), 1, sizeof(output), f);
-	err = ikClwindconWTCon_getOutput(&con, &output, "speed sensor manager>signal 3");
-	fwrite(&(output), 1, sizeof(output), f);
-}	
+	ikClwindconTurbine_step(&turbine, DATA);
+	
+	if (NINT(DATA[0]) == -1) {
+		ikClwindconTurbine_close(&turbine);
+	}
+	
+	/* give the caller its floating point mode back */
+	LEAVE_FTZ_DAZ(csr);
+}
@@ -0,0 +1,115 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file disconShim.c
+ *
+ * @brief DISCON shim, which forwards the calls to the controller server
+ *
+ * At the first call, the shim attaches to the controller server's shared memory link,
+ * whose name is given by environment variable OPENDISCON_SERVER, if set, and claims
+ * a slot, for the supercontroller turbine index given by environment variable
+ * OPENDISCON_TURBINE, if set. Every call is then forwarded to the server, and the
+ * slot is released at the last call, or if the server stops replying.
+ */
+
+#ifndef _WIN32
+/* realpath */
+#define _XOPEN_SOURCE 700
+#endif
+
+#define NINT(a) ((a) >= 0.0 ? (int) ((a)+0.5) : ((a)-0.5))
+
+#include <stdlib.h>
+#include <string.h>
+#include "ikDisconLink.h"
+#include "OpenDiscon_EXPORT.h"
+
+/* report an error to the simulator, which should then stop */
+static void setMessage(const float *DATA, int *FLAG, char *MESSAGE, const char *text) {
+	int n = NINT(DATA[48]); /* maximum number of characters in MESSAGE */
+	
+	if (NULL != FLAG) *FLAG = -1;
+	if (0 >= n) return;
+	strncpy(MESSAGE, text, n - 1);
+	MESSAGE[n - 1] = '\0';
+}
+
+void OpenDiscon_EXPORT DISCON(float *DATA, int *FLAG, const char *INFILE, const char *OUTNAME, char *MESSAGE) {
+	static ikDisconLink link;
+	static int slot = -1;
+	ikDisconLinkParams params;
+	char inFile[IKDISCONLINK_MAXFILE];
+#ifdef _WIN32
+	char path[IKDISCONLINK_MAXFILE];
+#else
+	char *path;
+#endif
+	char message[IKDISCONLINK_MAXMESSAGE];
+	const char *env;
+	int n;
+	int err;
+	
+	if (NINT(DATA[0]) == 0) {
+		/* attach to the server */
+		if (0 <= slot) {
+			ikDisconLink_release(&link, slot);
+			ikDisconLink_close(&link);
+			slot = -1;
+		}
+		ikDisconLink_initParams(&params);
+		env = getenv("OPENDISCON_SERVER");
+		if (NULL != env) params.name = env;
+		if (ikDisconLink_init(&link, &params)) {
+			setMessage(DATA, FLAG, MESSAGE, "OpenDiscon controller server not running");
+			return;
+		}
+		env = getenv("OPENDISCON_TURBINE");
+		slot = ikDisconLink_claim(&link, NULL != env ? atoi(env) : -1);
+		if (0 > slot) {
+			ikDisconLink_close(&link);
+			setMessage(DATA, FLAG, MESSAGE, "OpenDiscon controller server has no free slots");
+			return;
+		}
+		
+		/* the server runs elsewhere, so send it the full path of the parameter file */
+		n = NINT(DATA[49]); /* number of characters in INFILE */
+		n = 0 < n && n < (int) sizeof(inFile) ? n : (int) sizeof(inFile) - 1;
+		strncpy(inFile, INFILE, n);
+		inFile[n] = '\0';
+#ifdef _WIN32
+		if (NULL != _fullpath(path, inFile, sizeof(path))) strcpy(inFile, path);
+#else
+		path = realpath(inFile, NULL);
+		if (NULL != path && strlen(path) < sizeof(inFile)) strcpy(inFile, path);
+		free(path);
+#endif
+	}
+	if (0 > slot) return;
+	
+	err = ikDisconLink_call(&link, slot, DATA, NINT(DATA[0]) == 0 ? inFile : NULL, message);
+	if (-1 == err) setMessage(DATA, FLAG, MESSAGE, "OpenDiscon controller server not responding");
+	else if (err) setMessage(DATA, FLAG, MESSAGE, message);
+	
+	/* detach at the last call, or if the server has gone */
+	if (NINT(DATA[0]) == -1 || -1 == err) {
+		ikDisconLink_release(&link, slot);
+		ikDisconLink_close(&link);
+		slot = -1;
+	}
+}
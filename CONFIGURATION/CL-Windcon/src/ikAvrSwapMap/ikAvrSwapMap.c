@@ -0,0 +1,159 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikAvrSwapMap.c
+ * 
+ * @brief Class ikAvrSwapMap implementation
+ */
+
+/* @cond */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ikAvrSwapMap.h"
+
+static int ikAvrSwapMap_set(ikAvrSwapMapEntry *entries, int *n, double *value, int index, double scale, double offset, double min, double max) {
+	int i;
+	
+	/* find the conversion for this variable, or add one */
+	for (i = 0; i < *n; i++) {
+		if (entries[i].value == value) break;
+	}
+	if (IKAVRSWAPMAP_MAXENTRIES <= i) return -1;
+	if (i == *n) (*n)++;
+	
+	entries[i].index = index;
+	entries[i].value = value;
+	entries[i].scale = scale;
+	entries[i].offset = offset;
+	entries[i].min = min;
+	entries[i].max = max;
+	
+	return 0;
+}
+
+void ikAvrSwapMap_init(ikAvrSwapMap *self) {
+	self->nIn = 0;
+	self->nOut = 0;
+}
+
+int ikAvrSwapMap_setInput(ikAvrSwapMap *self, double *value, int index, double scale, double offset, double min, double max) {
+	if (-1 > index || IKAVRSWAPMAP_MAXINDEX <= index) return -2;
+	return ikAvrSwapMap_set(self->in, &(self->nIn), value, index, scale, offset, min, max);
+}
+
+int ikAvrSwapMap_setOutput(ikAvrSwapMap *self, double *value, int index, double scale, double offset, double min, double max) {
+	if (0 > index || IKAVRSWAPMAP_MAXINDEX <= index) return -2;
+	return ikAvrSwapMap_set(self->out, &(self->nOut), value, index, scale, offset, min, max);
+}
+
+int ikAvrSwapMap_load(ikAvrSwapMap *self, const char *fileName, const ikAvrSwapMapField *fields, int nFields) {
+	FILE *f;
+	char line[256];
+	char dir[8];
+	char name[IKAVRSWAPMAP_MAXNAME];
+	int index;
+	double scale;
+	double offset;
+	double min;
+	double max;
+	int n;
+	int i;
+	int err;
+	int nLoaded = 0;
+	int skipped = 0;
+	
+	f = fopen(fileName, "r");
+	if (NULL == f) return -1;
+	
+	while (NULL != fgets(line, sizeof(line), f)) {
+		/* pick up conversion lines only */
+		n = sscanf(line, "%7s %d %63s %lf %lf %lf %lf", dir, &index, name, &scale, &offset, &min, &max);
+		if (5 > n) continue;
+		if (strcmp(dir, "in") && strcmp(dir, "out")) continue;
+		if (7 > n) {
+			min = -1.0e300;
+			max = 1.0e300;
+		}
+		
+		/* find the variable */
+		for (i = 0; i < nFields; i++) {
+			if (!strcmp(name, fields[i].name)) break;
+		}
+		if (i >= nFields) {
+			skipped = 1;
+			continue;
+		}
+		
+		/* register the conversion */
+		if (!strcmp(dir, "in")) err = ikAvrSwapMap_setInput(self, fields[i].value, index, scale, offset, min, max);
+		else err = ikAvrSwapMap_setOutput(self, fields[i].value, index, scale, offset, min, max);
+		if (err) skipped = 1;
+		else nLoaded++;
+	}
+	
+	fclose(f);
+	
+	return skipped ? -2 : nLoaded;
+}
+
+void ikAvrSwapMap_gather(const ikAvrSwapMap *self, const float *data) {
+	int i;
+	double x;
+	const ikAvrSwapMapEntry *e;
+	
+	for (i = 0; i < self->nIn; i++) {
+		e = self->in + i;
+		x = 0 > e->index ? e->offset : e->scale*data[e->index] + e->offset;
+		x = x < e->min ? e->min : x;
+		x = x > e->max ? e->max : x;
+		*(e->value) = x;
+	}
+}
+
+void ikAvrSwapMap_scatter(const ikAvrSwapMap *self, float *data) {
+	int i;
+	double x;
+	const ikAvrSwapMapEntry *e;
+	
+	for (i = 0; i < self->nOut; i++) {
+		e = self->out + i;
+		x = e->scale*(*(e->value)) + e->offset;
+		x = x < e->min ? e->min : x;
+		x = x > e->max ? e->max : x;
+		data[e->index] = (float) x;
+	}
+}
+
+int ikAvrSwapMap_getSize(const ikAvrSwapMap *self) {
+	int i;
+	int n = 0;
+	
+	for (i = 0; i < self->nIn; i++) {
+		if (self->in[i].index >= n) n = self->in[i].index + 1;
+	}
+	for (i = 0; i < self->nOut; i++) {
+		if (self->out[i].index >= n) n = self->out[i].index + 1;
+	}
+	
+	return n;
+}
+
+/* @endcond */
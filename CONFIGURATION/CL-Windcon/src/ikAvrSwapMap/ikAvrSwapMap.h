@@ -0,0 +1,173 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikAvrSwapMap.h
+ * 
+ * @brief Class ikAvrSwapMap interface
+ */
+
+#ifndef IKAVRSWAPMAP_H
+#define IKAVRSWAPMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IKAVRSWAPMAP_MAXENTRIES 64
+#define IKAVRSWAPMAP_MAXNAME 64
+#define IKAVRSWAPMAP_MAXINDEX 4096
+
+    /**
+     * @struct ikAvrSwapMapField
+     * @brief Named controller variable which can be mapped to or from the avrSWAP array
+     */
+    typedef struct ikAvrSwapMapField {
+        const char *name; /**<name, without spaces, as used in map files*/
+        double *value; /**<variable*/
+    } ikAvrSwapMapField;
+
+    /**
+     * @struct ikAvrSwapMapEntry
+     * @brief Single avrSWAP array conversion
+     */
+    typedef struct ikAvrSwapMapEntry {
+        int index; /**<avrSWAP array index, starting from 0, or -1 for a constant input*/
+        double *value; /**<controller variable*/
+        double scale; /**<scale factor*/
+        double offset; /**<offset, added after scaling*/
+        double min; /**<lower limit, applied after scaling and offset*/
+        double max; /**<upper limit, applied after scaling and offset*/
+    } ikAvrSwapMapEntry;
+
+    /**
+     * @struct ikAvrSwapMap
+     * @brief avrSWAP array map
+     * 
+     * This describes how the controller variables are read from and written to the
+     * avrSWAP array of the DISCON interface, as a list of input and output conversions:
+     * @li input: variable = limit(scale*avrSWAP[index] + offset), or limit(offset) if index is -1
+     * @li output: avrSWAP[index] = limit(scale*variable + offset)
+     * 
+     * The conversions can be given in code, or loaded from a text file with one
+     * conversion per line, in the form
+     * @code
+     * in|out index name scale offset [min max]
+     * @endcode
+     * where name is one of a given list of fields. Each loaded conversion replaces any
+     * other conversion for the same variable, in the same direction, and lines which
+     * do not follow this form are ignored, so that the conversions can share a file
+     * with other parameters.
+     * 
+     * @par Methods
+     * @li @link ikAvrSwapMap_init @endlink initialise an instance
+     * @li @link ikAvrSwapMap_setInput @endlink set an input conversion
+     * @li @link ikAvrSwapMap_setOutput @endlink set an output conversion
+     * @li @link ikAvrSwapMap_load @endlink load conversions from a file
+     * @li @link ikAvrSwapMap_gather @endlink read the inputs from the avrSWAP array
+     * @li @link ikAvrSwapMap_scatter @endlink write the outputs to the avrSWAP array
+     * @li @link ikAvrSwapMap_getSize @endlink get the number of avrSWAP array records used
+     */
+    typedef struct ikAvrSwapMap {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int nIn;
+        ikAvrSwapMapEntry in[IKAVRSWAPMAP_MAXENTRIES];
+        int nOut;
+        ikAvrSwapMapEntry out[IKAVRSWAPMAP_MAXENTRIES];
+        /* @endcond */
+    } ikAvrSwapMap;
+
+    /**
+     * Initialise an instance, with no conversions
+     * @param self instance
+     */
+    void ikAvrSwapMap_init(ikAvrSwapMap *self);
+
+    /**
+     * Set an input conversion, replacing any other for the same variable
+     * @param self instance
+     * @param value controller variable
+     * @param index avrSWAP array index, starting from 0, or -1 for a constant
+     * @param scale scale factor
+     * @param offset offset, added after scaling
+     * @param min lower limit
+     * @param max upper limit
+     * @return error code:
+     * @li 0: no error
+     * @li -1: too many conversions, there may be at most IKAVRSWAPMAP_MAXENTRIES
+     * @li -2: invalid index, must be from -1 to IKAVRSWAPMAP_MAXINDEX - 1
+     */
+    int ikAvrSwapMap_setInput(ikAvrSwapMap *self, double *value, int index, double scale, double offset, double min, double max);
+
+    /**
+     * Set an output conversion, replacing any other for the same variable
+     * @param self instance
+     * @param value controller variable
+     * @param index avrSWAP array index, starting from 0
+     * @param scale scale factor
+     * @param offset offset, added after scaling
+     * @param min lower limit
+     * @param max upper limit
+     * @return error code:
+     * @li 0: no error
+     * @li -1: too many conversions, there may be at most IKAVRSWAPMAP_MAXENTRIES
+     * @li -2: invalid index, must be from 0 to IKAVRSWAPMAP_MAXINDEX - 1
+     */
+    int ikAvrSwapMap_setOutput(ikAvrSwapMap *self, double *value, int index, double scale, double offset, double min, double max);
+
+    /**
+     * Load conversions from a file
+     * @param self instance
+     * @param fileName file name
+     * @param fields variables which may be named in the file
+     * @param nFields number of variables
+     * @return number of conversions loaded, or error code:
+     * @li -1: the file cannot be opened
+     * @li -2: unknown variable name or invalid conversion, at least one line has been skipped
+     */
+    int ikAvrSwapMap_load(ikAvrSwapMap *self, const char *fileName, const ikAvrSwapMapField *fields, int nFields);
+
+    /**
+     * Read the inputs from the avrSWAP array
+     * @param self instance
+     * @param data avrSWAP array, with at least as many records as given by @link ikAvrSwapMap_getSize @endlink
+     */
+    void ikAvrSwapMap_gather(const ikAvrSwapMap *self, const float *data);
+
+    /**
+     * Write the outputs to the avrSWAP array
+     * @param self instance
+     * @param data avrSWAP array, with at least as many records as given by @link ikAvrSwapMap_getSize @endlink
+     */
+    void ikAvrSwapMap_scatter(const ikAvrSwapMap *self, float *data);
+
+    /**
+     * Get the number of avrSWAP array records used, i.e. the largest index plus 1
+     * @param self instance
+     * @return number of records
+     */
+    int ikAvrSwapMap_getSize(const ikAvrSwapMap *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKAVRSWAPMAP_H */
@@ -0,0 +1,159 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconFatigue.c
+ * 
+ * @brief Class ikClwindconFatigue implementation
+ */
+
+#include "ikClwindconFatigue.h"
+
+int ikClwindconFatigue_init(ikClwindconFatigue *self, const ikClwindconFatigueParams *params, const ikClwindconWTCon *con, const ikAvrSwapMapField *fields, int nFields) {
+	int i;
+	int err;
+	
+	self->n = 0;
+	self->steps = 0;
+	
+	/* check the parameters */
+	if (0 > params->n || IKCLWINDCONFATIGUE_MAXSIGNALS < params->n) return -1;
+	if (0.0 >= params->T) return -2;
+	if (0.0 >= params->equivalentFrequency) return -3;
+	for (i = 0; i < params->n; i++) {
+		if (ikRainflow_init(self->rainflow + i, params->rainflow + i)) return -4;
+	}
+	
+	/* register the parameters */
+	self->T = params->T;
+	self->frequency = params->equivalentFrequency;
+	err = ikClwindconProbe_init(&(self->probe), params->n, params->names, con, fields, nFields);
+	self->n = params->n;
+	for (i = 0; i < self->n; i++) {
+		self->names[i] = params->names[i];
+	}
+	
+	return err ? -5 : 0;
+}
+
+void ikClwindconFatigue_initParams(ikClwindconFatigueParams *params) {
+	/* monitor nothing */
+	params->n = 0;
+	params->T = 0.01;
+	params->equivalentFrequency = 1.0;
+}
+
+void ikClwindconFatigueSignals(ikClwindconFatigueParams *params) {
+	int i;
+	int j;
+	
+	/*! [Fatigue signals] */
+	/*
+	####################################################################
+	                    Fatigue signals
+
+	The load cycles of the following signals, named either as the
+	variables of the avrSWAP map or as accepted by
+	ikClwindconWTCon_getOutput, are rainflow counted, ignoring turns
+	smaller than gate, into nBins bins up to maxRange. Their
+	damage-equivalent loads at frequency f are reported for each of the
+	Wöhler exponents m in file fatigue.txt at the end of the simulation,
+	if switched on (on = 1; off by default).
+
+	Set parameters here:
+	*/
+	const int on = 0; /* [-] */
+	const int nBins = 32;
+	const double f = 1.0; /* [Hz] */
+	const double m[] = {4.0, 10.0}; /* [-] */
+	static const struct {
+		const char *name;
+		double maxRange;
+		double gate;
+	} signals[] = {
+		{"blade1OutOfPlaneMoment", 60.0e3, 10.0}, /* [kNm] */
+		{"blade2OutOfPlaneMoment", 60.0e3, 10.0}, /* [kNm] */
+		{"blade3OutOfPlaneMoment", 60.0e3, 10.0}, /* [kNm] */
+		{"blade1InPlaneMoment", 60.0e3, 10.0}, /* [kNm] */
+		{"blade2InPlaneMoment", 60.0e3, 10.0}, /* [kNm] */
+		{"blade3InPlaneMoment", 60.0e3, 10.0}, /* [kNm] */
+		{"individual pitch control>My", 40.0e3, 10.0}, /* [kNm] */
+		{"individual pitch control>Mz", 40.0e3, 10.0}, /* [kNm] */
+		{"torqueDemand", 300.0, 0.1}, /* [kNm] */
+	};
+	/*
+	####################################################################
+	*/
+	/*! [Fatigue signals] */
+	
+	params->equivalentFrequency = f;
+	params->n = on ? sizeof(signals)/sizeof(signals[0]) : 0;
+	for (i = 0; i < params->n; i++) {
+		params->names[i] = signals[i].name;
+		ikRainflow_initParams(params->rainflow + i);
+		params->rainflow[i].nBins = nBins;
+		params->rainflow[i].maxRange = signals[i].maxRange;
+		params->rainflow[i].gate = signals[i].gate;
+		params->rainflow[i].nExponents = sizeof(m)/sizeof(m[0]);
+		for (j = 0; j < params->rainflow[i].nExponents; j++) {
+			params->rainflow[i].exponents[j] = m[j];
+		}
+	}
+}
+
+void ikClwindconFatigue_step(ikClwindconFatigue *self, const ikClwindconWTCon *con) {
+	int i;
+	
+	if (0 == self->n) return;
+	self->steps++;
+	
+	ikClwindconProbe_sample(&(self->probe), con, self->values);
+	for (i = 0; i < self->n; i++) {
+		ikRainflow_step(self->rainflow + i, self->values[i]);
+	}
+}
+
+double ikClwindconFatigue_getDel(const ikClwindconFatigue *self, int i, int j) {
+	if (0 > i || self->n <= i) return 0.0;
+	return ikRainflow_getDel(self->rainflow + i, j, self->steps*self->T*self->frequency);
+}
+
+void ikClwindconFatigue_write(const ikClwindconFatigue *self, FILE *f) {
+	int i;
+	int j;
+	double width;
+	double counts[IKRAINFLOW_MAXBINS];
+	
+	fprintf(f, "# %lu steps, %.9g s, damage-equivalent loads at %.9g Hz\n", self->steps, self->steps*self->T, self->frequency);
+	fprintf(f, "# signal\tWöhler exponent\tdamage-equivalent load\n");
+	for (i = 0; i < self->n; i++) {
+		for (j = 0; j < self->rainflow[i].nExponents; j++) {
+			fprintf(f, "%s\t%.9g\t%.9g\n", self->names[i], self->rainflow[i].exponents[j], ikClwindconFatigue_getDel(self, i, j));
+		}
+	}
+	
+	fprintf(f, "# signal\tbin width\tcycles per bin\n");
+	for (i = 0; i < self->n; i++) {
+		width = ikRainflow_getHistogram(self->rainflow + i, counts);
+		fprintf(f, "%s\t%.9g", self->names[i], width);
+		for (j = 0; j < self->rainflow[i].nBins; j++) {
+			fprintf(f, "\t%.9g", counts[j]);
+		}
+		fprintf(f, "\n");
+	}
+}
@@ -0,0 +1,145 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconFatigue.h
+ * 
+ * @brief Class ikClwindconFatigue interface
+ */
+
+#ifndef IKCLWINDCONFATIGUE_H
+#define IKCLWINDCONFATIGUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include "ikClwindconProbe.h"
+#include "ikRainflow.h"
+
+#define IKCLWINDCONFATIGUE_MAXSIGNALS 16
+
+    /**
+     * @struct ikClwindconFatigue
+     * @brief Fatigue load monitor
+     * 
+     * This rainflow counts a list of signals of an @link ikClwindconWTCon @endlink
+     * instance, as sampled by an @link ikClwindconProbe @endlink, with an
+     * @link ikRainflow @endlink instance each, and reports their damage-equivalent
+     * loads and range histograms on demand.
+     * 
+     * @par Inputs
+     * @li controller: controller instance, specify via @link ikClwindconFatigue_step @endlink
+     * 
+     * @par Outputs
+     * @li damage-equivalent loads, get via @link ikClwindconFatigue_getDel @endlink
+     * @li report, get via @link ikClwindconFatigue_write @endlink
+     * 
+     * @par Methods
+     * @li @link ikClwindconFatigue_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikClwindconFatigue_init @endlink initialise an instance
+     * @li @link ikClwindconFatigue_step @endlink execute periodic calculations
+     * @li @link ikClwindconFatigue_getDel @endlink get a damage-equivalent load
+     * @li @link ikClwindconFatigue_write @endlink write a report
+     */
+    typedef struct ikClwindconFatigue {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int n;
+        const char *names[IKCLWINDCONFATIGUE_MAXSIGNALS];
+        ikClwindconProbe probe;
+        ikRainflow rainflow[IKCLWINDCONFATIGUE_MAXSIGNALS];
+        double values[IKCLWINDCONFATIGUE_MAXSIGNALS];
+        double T;
+        double frequency;
+        unsigned long steps;
+        /* @endcond */
+    } ikClwindconFatigue;
+
+    /**
+     * @struct ikClwindconFatigueParams
+     * @brief Fatigue load monitor initialisation parameters
+     */
+    typedef struct ikClwindconFatigueParams {
+        int n; /**<number of signals. The default value is 0.*/
+        const char *names[IKCLWINDCONFATIGUE_MAXSIGNALS]; /**<signal names, as for @link ikClwindconProbe_init @endlink. They must outlive the instance.*/
+        ikRainflowParams rainflow[IKCLWINDCONFATIGUE_MAXSIGNALS]; /**<rainflow counter parameters, for each signal*/
+        double T; /**<sampling interval in s. The default value is 0.01.*/
+        double equivalentFrequency; /**<frequency of the damage-equivalent loads in Hz. The default value is 1.0.*/
+    } ikClwindconFatigueParams;
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param params initialisation parameters
+     * @param con controller instance
+     * @param fields named controller variables, which must outlive the instance
+     * @param nFields number of named controller variables
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of signals, must be between 0 and IKCLWINDCONFATIGUE_MAXSIGNALS
+     * @li -2: invalid sampling interval, must be positive
+     * @li -3: invalid equivalent frequency, must be positive
+     * @li -4: invalid rainflow counter parameters
+     * @li -5: unknown signal name, the signal is counted as 0
+     */
+    int ikClwindconFatigue_init(ikClwindconFatigue *self, const ikClwindconFatigueParams *params, const ikClwindconWTCon *con, const ikAvrSwapMapField *fields, int nFields);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikClwindconFatigue_initParams(ikClwindconFatigueParams *params);
+
+    /**
+     * Set the list of signals monitored for CL-Windcon
+     * @param params initialisation parameter structure
+     */
+    void ikClwindconFatigueSignals(ikClwindconFatigueParams *params);
+
+    /**
+     * Execute periodic calculations
+     * @param self instance
+     * @param con controller instance, after its step
+     */
+    void ikClwindconFatigue_step(ikClwindconFatigue *self, const ikClwindconWTCon *con);
+
+    /**
+     * Get a damage-equivalent load, so far
+     * @param self instance
+     * @param i signal index
+     * @param j Wöhler exponent index
+     * @return damage-equivalent load, or 0 if an index is invalid or nothing has been counted yet
+     */
+    double ikClwindconFatigue_getDel(const ikClwindconFatigue *self, int i, int j);
+
+    /**
+     * Write a report of the damage-equivalent loads and range histograms so far
+     * @param self instance
+     * @param f file to write to
+     */
+    void ikClwindconFatigue_write(const ikClwindconFatigue *self, FILE *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKCLWINDCONFATIGUE_H */
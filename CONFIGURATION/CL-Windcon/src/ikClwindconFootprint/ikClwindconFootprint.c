@@ -0,0 +1,50 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconFootprint.c
+ *
+ * @brief CL-Windcon wind turbine controller memory footprint report
+ */
+
+#include "ikClwindconFootprint.h"
+
+/* @cond */
+
+#define CACHE_LINE 64
+
+static void ikClwindconFootprintLine(FILE *f, const char *name, size_t size) {
+	fprintf(f, "%s\t%lu\t%lu\n", name, (unsigned long) size, (unsigned long) ((size + CACHE_LINE - 1)/CACHE_LINE));
+}
+
+/* @endcond */
+
+void ikClwindconFootprint(FILE *f) {
+	fprintf(f, "# block\tbytes\tcache lines\n");
+	ikClwindconFootprintLine(f, "ikClwindconWTCon", sizeof(ikClwindconWTCon));
+	ikClwindconFootprintLine(f, "ikClwindconWTConParams", sizeof(ikClwindconWTConParams));
+	ikClwindconFootprintLine(f, "ikConLoop", sizeof(ikConLoop));
+	ikClwindconFootprintLine(f, "ikIpc", sizeof(ikIpc));
+	ikClwindconFootprintLine(f, "ikTpman", sizeof(ikTpman));
+	ikClwindconFootprintLine(f, "ikSpdman", sizeof(ikSpdman));
+	ikClwindconFootprintLine(f, "ikTrackingNotch", sizeof(ikTrackingNotch));
+	ikClwindconFootprintLine(f, "ikPowman", sizeof(ikPowman));
+	ikClwindconFootprintLine(f, "ikPowmanTuning", sizeof(ikPowmanTuning));
+	ikClwindconFootprintLine(f, "ikFastLutbl", sizeof(ikFastLutbl));
+	ikClwindconFootprintLine(f, "ikFastLutblTable", sizeof(ikFastLutblTable));
+}
@@ -0,0 +1,47 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconFootprint.h
+ * 
+ * @brief CL-Windcon wind turbine controller memory footprint report interface
+ */
+
+#ifndef IKCLWINDCONFOOTPRINT_H
+#define IKCLWINDCONFOOTPRINT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include "ikClwindconWTCon.h"  
+
+	/**
+	 * Write the memory footprint of the controller and its blocks, one line
+	 * per block with its name, its size in bytes and the number of 64 byte
+	 * cache lines it spans.
+	 * @param f file to write to
+	 */
+	void ikClwindconFootprint(FILE *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKCLWINDCONFOOTPRINT_H */
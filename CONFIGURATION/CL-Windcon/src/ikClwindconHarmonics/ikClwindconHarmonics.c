@@ -0,0 +1,157 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconHarmonics.c
+ * 
+ * @brief Class ikClwindconHarmonics implementation
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "ikClwindconHarmonics.h"
+#include "ikClwindconWTConfig.h"
+
+int ikClwindconHarmonics_init(ikClwindconHarmonics *self, const ikClwindconHarmonicsParams *params, const ikClwindconWTCon *con, const ikAvrSwapMapField *fields, int nFields) {
+	int i;
+	int j;
+	int err;
+	const char *names[IKHARMONICMONITOR_MAXSIGNALS + 1];
+	
+	self->n = 0;
+	self->nHarmonics = 0;
+	
+	/* no signals, no monitors */
+	if (0 == params->monitor.nSignals) return 0;
+	
+	if (ikHarmonicMonitor_init(&(self->monitor), &(params->monitor))) return -1;
+	
+	/* name the amplitudes */
+	for (i = 0; i < params->monitor.nSignals; i++) {
+		for (j = 0; j < params->monitor.nHarmonics; j++) {
+			if (IKCLWINDCONHARMONICS_MAXNAME <= strlen(params->names[i]) + 16) return -2;
+			sprintf(self->names[i*params->monitor.nHarmonics + j], "%s %gP", params->names[i], params->monitor.harmonics[j]);
+			self->amplitudes[i*params->monitor.nHarmonics + j] = 0.0;
+		}
+	}
+	
+	/* sample the generator speed after the signals */
+	for (i = 0; i < params->monitor.nSignals; i++) {
+		names[i] = params->names[i];
+	}
+	names[params->monitor.nSignals] = params->speedName;
+	err = ikClwindconProbe_init(&(self->probe), params->monitor.nSignals + 1, names, con, fields, nFields);
+	self->n = params->monitor.nSignals;
+	self->nHarmonics = params->monitor.nHarmonics;
+	
+	return err ? -3 : 0;
+}
+
+void ikClwindconHarmonics_initParams(ikClwindconHarmonicsParams *params) {
+	/* monitor nothing */
+	ikHarmonicMonitor_initParams(&(params->monitor));
+	params->monitor.nSignals = 0;
+	params->speedName = "generator speed equivalent";
+}
+
+void ikClwindconHarmonicSignals(ikClwindconHarmonicsParams *params) {
+	int i;
+	
+	/*! [Harmonic monitors] */
+	/*
+	####################################################################
+	                    Harmonic monitors
+
+	The amplitudes of the given harmonics of the rotor speed are
+	estimated for the following signals, named either as the variables
+	of the avrSWAP map or as accepted by ikClwindconWTCon_getOutput,
+	over windows of the given number of rotor revolutions. The rotor
+	speed is taken from the speed sensor manager output, divided by the
+	gearbox ratio given in ikClwindconWTConfig.c. Each amplitude is
+	named after its signal and harmonic, e.g. "blade1OutOfPlaneMoment
+	1P". The monitors only run if switched on (on = 1; off by default).
+
+	Set parameters here:
+	*/
+	const int on = 0; /* [-] */
+	const double revolutions = 4.0; /* [-] */
+	const double harmonics[] = {1.0, 2.0, 3.0}; /* [-] */
+	static const char *names[] = {
+		"blade1OutOfPlaneMoment",
+		"blade2OutOfPlaneMoment",
+		"blade3OutOfPlaneMoment",
+		"blade1InPlaneMoment",
+		"individual pitch control>My",
+		"individual pitch control>Mz",
+		"generator speed equivalent",
+	};
+	/*
+	####################################################################
+	*/
+	/*! [Harmonic monitors] */
+	
+	params->monitor.gearboxRatio = getGearboxRatio();
+	params->monitor.revolutions = revolutions;
+	params->monitor.nHarmonics = sizeof(harmonics)/sizeof(harmonics[0]);
+	for (i = 0; i < params->monitor.nHarmonics; i++) {
+		params->monitor.harmonics[i] = harmonics[i];
+	}
+	params->monitor.nSignals = on ? sizeof(names)/sizeof(names[0]) : 0;
+	for (i = 0; i < params->monitor.nSignals; i++) {
+		params->names[i] = names[i];
+	}
+}
+
+void ikClwindconHarmonics_step(ikClwindconHarmonics *self, const ikClwindconWTCon *con) {
+	int i;
+	int j;
+	
+	if (0 == self->n) return;
+	
+	ikClwindconProbe_sample(&(self->probe), con, self->samples);
+	ikHarmonicMonitor_step(&(self->monitor), self->samples, self->samples[self->n]);
+	for (i = 0; i < self->n; i++) {
+		for (j = 0; j < self->nHarmonics; j++) {
+			self->amplitudes[i*self->nHarmonics + j] = ikHarmonicMonitor_getAmplitude(&(self->monitor), i, j);
+		}
+	}
+}
+
+int ikClwindconHarmonics_getOutput(const ikClwindconHarmonics *self, double *output, const char *name) {
+	int i;
+	
+	for (i = 0; i < self->n*self->nHarmonics; i++) {
+		if (!strcmp(name, self->names[i])) {
+			*output = self->amplitudes[i];
+			return 0;
+		}
+	}
+	
+	return -1;
+}
+
+int ikClwindconHarmonics_getFields(ikClwindconHarmonics *self, ikAvrSwapMapField *fields, int max) {
+	int i;
+	
+	for (i = 0; i < self->n*self->nHarmonics && i < max; i++) {
+		fields[i].name = self->names[i];
+		fields[i].value = self->amplitudes + i;
+	}
+	
+	return i;
+}
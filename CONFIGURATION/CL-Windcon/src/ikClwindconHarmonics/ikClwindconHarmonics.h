@@ -0,0 +1,148 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconHarmonics.h
+ * 
+ * @brief Class ikClwindconHarmonics interface
+ */
+
+#ifndef IKCLWINDCONHARMONICS_H
+#define IKCLWINDCONHARMONICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ikClwindconProbe.h"
+#include "ikHarmonicMonitor.h"
+
+#define IKCLWINDCONHARMONICS_MAXOUTPUTS (IKHARMONICMONITOR_MAXSIGNALS*IKHARMONICMONITOR_MAXHARMONICS)
+#define IKCLWINDCONHARMONICS_MAXNAME 96
+
+    /**
+     * @struct ikClwindconHarmonics
+     * @brief Rotor harmonic monitors
+     * 
+     * This estimates the amplitudes of rotor speed harmonics, e.g. 1P, 2P and 3P, of
+     * signals of an @link ikClwindconWTCon @endlink instance, as sampled by an
+     * @link ikClwindconProbe @endlink, with an @link ikHarmonicMonitor @endlink tracking
+     * the generator speed given by the speed sensor manager.
+     * 
+     * The amplitudes are named after the signal and the harmonic, e.g.
+     * "blade1OutOfPlaneMoment 1P" or "individual pitch control>My 3P", and can be
+     * sampled like any other named controller variable once added to those via
+     * @link ikClwindconHarmonics_getFields @endlink.
+     * 
+     * @par Inputs
+     * @li controller: controller instance, specify via @link ikClwindconHarmonics_step @endlink
+     * 
+     * @par Outputs
+     * @li amplitudes: get via @link ikClwindconHarmonics_getOutput @endlink or @link ikClwindconHarmonics_getFields @endlink
+     * 
+     * @par Methods
+     * @li @link ikClwindconHarmonics_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikClwindconHarmonics_init @endlink initialise an instance
+     * @li @link ikClwindconHarmonics_step @endlink execute periodic calculations
+     * @li @link ikClwindconHarmonics_getOutput @endlink get output value
+     * @li @link ikClwindconHarmonics_getFields @endlink get the amplitudes as named controller variables
+     */
+    typedef struct ikClwindconHarmonics {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int n;
+        int nHarmonics;
+        ikClwindconProbe probe;
+        ikHarmonicMonitor monitor;
+        double samples[IKHARMONICMONITOR_MAXSIGNALS + 1];
+        double amplitudes[IKCLWINDCONHARMONICS_MAXOUTPUTS];
+        char names[IKCLWINDCONHARMONICS_MAXOUTPUTS][IKCLWINDCONHARMONICS_MAXNAME];
+        /* @endcond */
+    } ikClwindconHarmonics;
+
+    /**
+     * @struct ikClwindconHarmonicsParams
+     * @brief Rotor harmonic monitors initialisation parameters
+     */
+    typedef struct ikClwindconHarmonicsParams {
+        ikHarmonicMonitorParams monitor; /**<harmonic monitor parameters. The number of signals is 0 by default, which disables the monitors.*/
+        const char *names[IKHARMONICMONITOR_MAXSIGNALS]; /**<signal names, as for @link ikClwindconProbe_init @endlink. They must outlive the instance.*/
+        const char *speedName; /**<generator speed signal name, as for @link ikClwindconProbe_init @endlink. It must outlive the instance. The default value is "generator speed equivalent".*/
+    } ikClwindconHarmonicsParams;
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param params initialisation parameters
+     * @param con controller instance
+     * @param fields named controller variables, which must outlive the instance
+     * @param nFields number of named controller variables
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid harmonic monitor parameters
+     * @li -2: signal name too long
+     * @li -3: unknown signal name, the signal is sampled as 0
+     */
+    int ikClwindconHarmonics_init(ikClwindconHarmonics *self, const ikClwindconHarmonicsParams *params, const ikClwindconWTCon *con, const ikAvrSwapMapField *fields, int nFields);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikClwindconHarmonics_initParams(ikClwindconHarmonicsParams *params);
+
+    /**
+     * Set the list of signals monitored for CL-Windcon
+     * @param params initialisation parameter structure
+     */
+    void ikClwindconHarmonicSignals(ikClwindconHarmonicsParams *params);
+
+    /**
+     * Execute periodic calculations
+     * @param self instance
+     * @param con controller instance, after its step
+     */
+    void ikClwindconHarmonics_step(ikClwindconHarmonics *self, const ikClwindconWTCon *con);
+
+    /**
+     * Get output value by name
+     * @param self instance
+     * @param output output value
+     * @param name output name, e.g. "blade1OutOfPlaneMoment 1P"
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid signal name
+     */
+    int ikClwindconHarmonics_getOutput(const ikClwindconHarmonics *self, double *output, const char *name);
+
+    /**
+     * Get the amplitudes as named controller variables
+     * @param self instance
+     * @param fields named controller variables, to fill in
+     * @param max maximum number of named controller variables to fill in
+     * @return number of named controller variables filled in
+     */
+    int ikClwindconHarmonics_getFields(ikClwindconHarmonics *self, ikAvrSwapMapField *fields, int max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKCLWINDCONHARMONICS_H */
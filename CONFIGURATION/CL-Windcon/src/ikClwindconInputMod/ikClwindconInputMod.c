@@ -25,14 +25,13 @@ along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
 
 #include "ikClwindconInputMod.h"
 
-void ikClwindconInputMod(ikClwindconWTConInputs *in) {
+void ikClwindconInputMod(ikClwindconWTConInputs *in, int step) {
 
-	ikGeneratorSpeedSingalFail(in);
+	ikGeneratorSpeedSingalFail(in, step);
 
 }
 
-void ikGeneratorSpeedSingalFail(ikClwindconWTConInputs *in) {
-	static int _n = 0;
+void ikGeneratorSpeedSingalFail(ikClwindconWTConInputs *in, int step) {
 	
 	/*! [Speed sensor fault] */
 	/*
@@ -51,10 +50,7 @@ void ikGeneratorSpeedSingalFail(ikClwindconWTConInputs *in) {
 	*/
 	/*! [Speed sensor fault] */
 	
-	if (0 < N && _n < N) {
-		_n++;
-		return;
-	}
+	if (0 < N && step < N) return;
 	
 	in->generatorSpeed = val;
 	
@@ -32,8 +32,8 @@ extern "C" {
 
 #include "ikClwindconWTCon.h"  
 
-	void ikClwindconInputMod(ikClwindconWTConInputs *in);
-	void ikGeneratorSpeedSingalFail(ikClwindconWTConInputs *in);
+	void ikClwindconInputMod(ikClwindconWTConInputs *in, int step);
+	void ikGeneratorSpeedSingalFail(ikClwindconWTConInputs *in, int step);
 
 #ifdef __cplusplus
 }
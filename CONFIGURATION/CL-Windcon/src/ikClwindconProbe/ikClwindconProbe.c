@@ -0,0 +1,72 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconProbe.c
+ * 
+ * @brief Class ikClwindconProbe implementation
+ */
+
+#include <string.h>
+#include "ikClwindconProbe.h"
+
+/* @cond */
+static const double ikClwindconProbe_zero = 0.0;
+/* @endcond */
+
+int ikClwindconProbe_init(ikClwindconProbe *self, int n, const char * const *names, const ikClwindconWTCon *con, const ikAvrSwapMapField *fields, int nFields) {
+	int i;
+	int j;
+	int err = 0;
+	double value;
+	
+	self->n = 0;
+	if (0 > n || IKCLWINDCONPROBE_MAXSIGNALS < n) return -1;
+	self->n = n;
+	
+	for (i = 0; i < n; i++) {
+		self->names[i] = names[i];
+		self->variables[i] = NULL;
+		
+		/* named variables are read directly */
+		for (j = 0; j < nFields; j++) {
+			if (!strcmp(names[i], fields[j].name)) {
+				self->variables[i] = fields[j].value;
+				break;
+			}
+		}
+		if (j < nFields) continue;
+		
+		/* anything else must be an internal signal */
+		if (ikClwindconWTCon_getOutput(con, &value, names[i])) {
+			self->variables[i] = &ikClwindconProbe_zero;
+			err = -2;
+		}
+	}
+	
+	return err;
+}
+
+void ikClwindconProbe_sample(const ikClwindconProbe *self, const ikClwindconWTCon *con, double *values) {
+	int i;
+	
+	for (i = 0; i < self->n; i++) {
+		if (NULL != self->variables[i]) values[i] = *(self->variables[i]);
+		else ikClwindconWTCon_getOutput(con, values + i, self->names[i]);
+	}
+}
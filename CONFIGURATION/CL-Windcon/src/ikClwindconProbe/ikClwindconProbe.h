@@ -0,0 +1,94 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconProbe.h
+ * 
+ * @brief Class ikClwindconProbe interface
+ */
+
+#ifndef IKCLWINDCONPROBE_H
+#define IKCLWINDCONPROBE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ikClwindconWTCon.h"
+#include "ikAvrSwapMap.h"
+
+#define IKCLWINDCONPROBE_MAXSIGNALS 64
+
+    /**
+     * @struct ikClwindconProbe
+     * @brief Sampler of named controller signals
+     * 
+     * This samples a list of signals by name, each being either a named controller
+     * variable, such as an input read from the avrSWAP array, or an internal signal, as
+     * accessible via @link ikClwindconWTCon_getOutput @endlink. Named variables are
+     * resolved once, at initialisation, and read directly at each sample.
+     * 
+     * @par Inputs
+     * @li controller: controller instance, specify via @link ikClwindconProbe_sample @endlink
+     * 
+     * @par Outputs
+     * @li values: signal values, get via @link ikClwindconProbe_sample @endlink
+     * 
+     * @par Methods
+     * @li @link ikClwindconProbe_init @endlink initialise an instance
+     * @li @link ikClwindconProbe_sample @endlink sample the signals
+     */
+    typedef struct ikClwindconProbe {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int n;
+        const char *names[IKCLWINDCONPROBE_MAXSIGNALS];
+        const double *variables[IKCLWINDCONPROBE_MAXSIGNALS];
+        /* @endcond */
+    } ikClwindconProbe;
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param n number of signals
+     * @param names signal names, which must outlive the instance
+     * @param con controller instance, to check the internal signal names
+     * @param fields named controller variables, which must outlive the instance
+     * @param nFields number of named controller variables
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of signals, must be between 0 and IKCLWINDCONPROBE_MAXSIGNALS
+     * @li -2: unknown signal name, the signal is sampled as 0
+     */
+    int ikClwindconProbe_init(ikClwindconProbe *self, int n, const char * const *names, const ikClwindconWTCon *con, const ikAvrSwapMapField *fields, int nFields);
+
+    /**
+     * Sample the signals
+     * @param self instance
+     * @param con controller instance, after its step
+     * @param values signal values, as many as signals
+     */
+    void ikClwindconProbe_sample(const ikClwindconProbe *self, const ikClwindconWTCon *con, double *values);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKCLWINDCONPROBE_H */
@@ -0,0 +1,172 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconRangeProfiler.c
+ * 
+ * @brief Class ikClwindconRangeProfiler implementation
+ */
+
+#include <string.h>
+#include <math.h>
+#include "ikClwindconRangeProfiler.h"
+
+/* @cond */
+
+/* number of integer bits, excluding sign, needed for a range, 1024 if not finite */
+static int ikClwindconRangeProfiler_bits(double min, double max) {
+	double m;
+	int bits;
+	
+	m = fabs(min) > fabs(max) ? fabs(min) : fabs(max);
+	bits = 0;
+	while (!(m < 1.0) && bits < 1024) {
+		m *= 0.5;
+		bits++;
+	}
+	
+	return bits;
+}
+
+/* @endcond */
+
+int ikClwindconRangeProfiler_init(ikClwindconRangeProfiler *self, const ikClwindconRangeProfilerParams *params) {
+	int i;
+	
+	/* register the signal names */
+	if (0 > params->n || IKCLWINDCONRANGEPROFILER_MAXSIGNALS < params->n) return -1;
+	for (i = 0; i < params->n; i++) {
+		if (IKCLWINDCONRANGEPROFILER_MAXNAME <= strlen(params->names[i])) return -2;
+	}
+	self->n = params->n;
+	for (i = 0; i < self->n; i++) {
+		strcpy(self->names[i], params->names[i]);
+		self->valid[i] = 0;
+		self->min[i] = 0.0;
+		self->max[i] = 0.0;
+	}
+	self->steps = 0;
+	
+	return 0;
+}
+
+void ikClwindconRangeProfiler_initParams(ikClwindconRangeProfilerParams *params) {
+	/* profile nothing */
+	params->n = 0;
+}
+
+void ikClwindconRangeSignals(ikClwindconRangeProfilerParams *params) {
+	int i;
+	
+	/*! [Profiled signals] */
+	/*
+	####################################################################
+	                    Profiled signals
+
+	The ranges of the following signals are recorded, with names as
+	accepted by ikClwindconWTCon_getOutput.
+
+	Set parameters here:
+	*/
+	static const char *names[] = {
+		"generator speed equivalent",
+		"notched generator speed",
+		"torque demand from torque control",
+		"torque demand from drivetrain damper",
+		"minimum torque",
+		"maximum torque",
+		"minimum pitch",
+		"maximum pitch",
+		"collective pitch demand",
+		"individual pitch for yaw",
+		"power manager>below rated torque",
+		"speed sensor manager>signal 1",
+		"speed sensor manager>signal 2",
+		"speed sensor manager>signal 3",
+		"drivetrain damper>control action",
+		"torque control>control action",
+		"collective pitch control>control action",
+		"yaw by ipc>control action",
+		"individual pitch control>My",
+		"individual pitch control>Mz",
+		"individual pitch control>pitch y from control",
+		"individual pitch control>pitch z from control",
+	};
+	/*
+	####################################################################
+	*/
+	/*! [Profiled signals] */
+	
+	params->n = sizeof(names)/sizeof(names[0]);
+	for (i = 0; i < params->n; i++) {
+		params->names[i] = names[i];
+	}
+}
+
+void ikClwindconRangeProfiler_step(ikClwindconRangeProfiler *self, const ikClwindconWTCon *con) {
+	int i;
+	double value;
+	
+	/* update the ranges */
+	for (i = 0; i < self->n; i++) {
+		if (ikClwindconWTCon_getOutput(con, &value, self->names[i])) continue;
+		if (!self->valid[i]) {
+			self->min[i] = value;
+			self->max[i] = value;
+			self->valid[i] = 1;
+		}
+		self->min[i] = value < self->min[i] ? value : self->min[i];
+		self->max[i] = value > self->max[i] ? value : self->max[i];
+	}
+	self->steps++;
+}
+
+int ikClwindconRangeProfiler_getRange(const ikClwindconRangeProfiler *self, double *min, double *max, int *bits, const char *name) {
+	int i;
+	
+	/* find the signal */
+	for (i = 0; i < self->n; i++) {
+		if (!strcmp(name, self->names[i])) break;
+	}
+	if (i >= self->n) return -1;
+	if (!self->valid[i]) return -2;
+	
+	*min = self->min[i];
+	*max = self->max[i];
+	*bits = ikClwindconRangeProfiler_bits(self->min[i], self->max[i]);
+	
+	return 0;
+}
+
+void ikClwindconRangeProfiler_write(const ikClwindconRangeProfiler *self, FILE *f) {
+	int i;
+	int bits;
+	
+	fprintf(f, "# %lu steps\n", self->steps);
+	fprintf(f, "# signal\tminimum\tmaximum\tinteger bits\tformat\n");
+	for (i = 0; i < self->n; i++) {
+		if (!self->valid[i]) {
+			fprintf(f, "%s\t-\t-\t-\t-\n", self->names[i]);
+			continue;
+		}
+		bits = ikClwindconRangeProfiler_bits(self->min[i], self->max[i]);
+		/* a signed 32 bit word has 31 bits besides the sign */
+		if (31 < bits) fprintf(f, "%s\t%.9g\t%.9g\t%d\tdoes not fit in 32 bits\n", self->names[i], self->min[i], self->max[i], bits);
+		else fprintf(f, "%s\t%.9g\t%.9g\t%d\tQ%d.%d\n", self->names[i], self->min[i], self->max[i], bits, bits, 31 - bits);
+	}
+}
@@ -0,0 +1,140 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconRangeProfiler.h
+ * 
+ * @brief Class ikClwindconRangeProfiler interface
+ */
+
+#ifndef IKCLWINDCONRANGEPROFILER_H
+#define IKCLWINDCONRANGEPROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include "ikClwindconWTCon.h"
+
+#define IKCLWINDCONRANGEPROFILER_MAXSIGNALS 64
+#define IKCLWINDCONRANGEPROFILER_MAXNAME 128
+
+    /**
+     * @struct ikClwindconRangeProfiler
+     * @brief Dynamic range profiler
+     * 
+     * This records the minimum and maximum values taken by a list of internal
+     * signals of an @link ikClwindconWTCon @endlink instance, as accessible via
+     * @link ikClwindconWTCon_getOutput @endlink, over a simulation. The ranges
+     * can then be used to choose fixed-point formats for those signals.
+     * 
+     * @par Inputs
+     * @li controller: controller instance, specify via @link ikClwindconRangeProfiler_step @endlink
+     * 
+     * @par Outputs
+     * @li report: range and number of integer bits of each signal, get via @link ikClwindconRangeProfiler_write @endlink
+     * 
+     * @par Methods
+     * @li @link ikClwindconRangeProfiler_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikClwindconRangeProfiler_init @endlink initialise an instance
+     * @li @link ikClwindconRangeProfiler_step @endlink execute periodic calculations
+     * @li @link ikClwindconRangeProfiler_getRange @endlink get the range of a signal
+     * @li @link ikClwindconRangeProfiler_write @endlink write the report
+     */
+    typedef struct ikClwindconRangeProfiler {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int n;
+        char names[IKCLWINDCONRANGEPROFILER_MAXSIGNALS][IKCLWINDCONRANGEPROFILER_MAXNAME];
+        int valid[IKCLWINDCONRANGEPROFILER_MAXSIGNALS];
+        double min[IKCLWINDCONRANGEPROFILER_MAXSIGNALS];
+        double max[IKCLWINDCONRANGEPROFILER_MAXSIGNALS];
+        unsigned long steps;
+        /* @endcond */
+    } ikClwindconRangeProfiler;
+
+    /**
+     * @struct ikClwindconRangeProfilerParams
+     * @brief Dynamic range profiler initialisation parameters
+     */
+    typedef struct ikClwindconRangeProfilerParams {
+        int n; /**<number of signals. The default value is 0.*/
+        const char *names[IKCLWINDCONRANGEPROFILER_MAXSIGNALS]; /**<signal names, as for @link ikClwindconWTCon_getOutput @endlink*/
+    } ikClwindconRangeProfilerParams;
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of signals, must be between 0 and IKCLWINDCONRANGEPROFILER_MAXSIGNALS
+     * @li -2: invalid signal name, must be shorter than IKCLWINDCONRANGEPROFILER_MAXNAME characters
+     */
+    int ikClwindconRangeProfiler_init(ikClwindconRangeProfiler *self, const ikClwindconRangeProfilerParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikClwindconRangeProfiler_initParams(ikClwindconRangeProfilerParams *params);
+
+    /**
+     * Set the list of signals profiled for CL-Windcon
+     * @param params initialisation parameter structure
+     */
+    void ikClwindconRangeSignals(ikClwindconRangeProfilerParams *params);
+
+    /**
+     * Execute periodic calculations
+     * @param self instance
+     * @param con controller instance, after its step
+     */
+    void ikClwindconRangeProfiler_step(ikClwindconRangeProfiler *self, const ikClwindconWTCon *con);
+
+    /**
+     * Get the range of a signal
+     * @param self instance
+     * @param min minimum value
+     * @param max maximum value
+     * @param bits number of integer bits, excluding the sign bit, needed to represent the range, or 1024 if it is not finite
+     * @param name signal name
+     * @return error code:
+     * @li 0: no error
+     * @li -1: signal not profiled
+     * @li -2: no value recorded, either because no step was run or because the controller does not recognise the name
+     */
+    int ikClwindconRangeProfiler_getRange(const ikClwindconRangeProfiler *self, double *min, double *max, int *bits, const char *name);
+
+    /**
+     * Write the report, one line per signal with its name, minimum value, maximum value,
+     * number of integer bits excluding the sign bit, and the corresponding 32 bit Q format,
+     * or "does not fit in 32 bits" if more than 31 integer bits are needed
+     * @param self instance
+     * @param f file to write to
+     */
+    void ikClwindconRangeProfiler_write(const ikClwindconRangeProfiler *self, FILE *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKCLWINDCONRANGEPROFILER_H */
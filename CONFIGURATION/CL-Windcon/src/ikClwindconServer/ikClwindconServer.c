@@ -0,0 +1,205 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconServer.c
+ *
+ * @brief Controller server
+ *
+ * Hosts the controllers of the turbines whose simulators load the DISCON shim,
+ * one per slot of the shared memory link, and serves their calls with a number
+ * of worker threads, each taking care of a share of the slots. Usage:
+ * @code
+ * ikClwindconServer [nSlots [nThreads [linkName]]]
+ * @endcode
+ * The log of the turbine in slot i is written to log<i>.bin in the working
+ * directory of the server, and its telemetry board is suffixed with i. Stop the server with Ctrl+C, between simulations.
+ */
+
+#define NINT(a) ((a) >= 0.0 ? (int) ((a)+0.5) : ((a)-0.5))
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <pthread.h>
+#include "ikDisconLink.h"
+#include "ikClwindconTurbine.h"
+
+/* flush denormals to zero, where SSE is available */
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FTZ_DAZ_BITS 0x8040u /* flush to zero (bit 15) and denormals are zero (bit 6) */
+#define SET_FTZ_DAZ() _mm_setcsr(_mm_getcsr() | FTZ_DAZ_BITS)
+#else
+#define SET_FTZ_DAZ()
+#endif
+
+/* longest wait for a call, in ms, so that stop requests are noticed */
+#define WAIT 100
+
+typedef struct worker {
+	ikDisconLink *link;
+	ikClwindconTurbine *turbines;
+	int *active;
+	int first;
+	int stride;
+	int nSlots;
+	pthread_t thread;
+} worker;
+
+static volatile sig_atomic_t stop = 0;
+
+static void onSignal(int sig) {
+	(void) sig;
+	stop = 1;
+}
+
+static void serve(worker *w, int slot) {
+	float *data = ikDisconLink_getData(w->link, slot);
+	ikClwindconTurbine *turbine = w->turbines + slot;
+	char suffix[16];
+	int err;
+	
+	/* set the controller up at the first call */
+	if (NINT(data[0]) == 0) {
+		if (w->active[slot]) ikClwindconTurbine_close(turbine);
+		w->active[slot] = 0;
+		sprintf(suffix, "%d", slot);
+		err = ikClwindconTurbine_init(turbine, (double) data[2], ikDisconLink_getInFile(w->link, slot), suffix, ikDisconLink_getTurbine(w->link, slot));
+		if (-1 == err) {
+			ikClwindconTurbine_close(turbine);
+			ikDisconLink_reply(w->link, slot, -1, "OpenDiscon controller could not be initialised");
+			return;
+		}
+		w->active[slot] = 1;
+		if (-2 == err || -7 == err) {
+			ikClwindconTurbine_close(turbine);
+			w->active[slot] = 0;
+			ikDisconLink_reply(w->link, slot, -1, -2 == err ? "OpenDiscon log or statistics file could not be opened" : "OpenDiscon avrSWAP map in the controller parameter file is invalid");
+			return;
+		}
+		if (ikClwindconTurbine_checkSwapSize(turbine, data)) {
+			ikClwindconTurbine_close(turbine);
+			w->active[slot] = 0;
+			ikDisconLink_reply(w->link, slot, -1, "OpenDiscon avrSWAP map uses records at or beyond the logging outputs given by record 63");
+			return;
+		}
+		if (ikDisconLink_getSize(w->link, slot) < ikClwindconTurbine_getSwapSize(turbine)) {
+			ikClwindconTurbine_close(turbine);
+			w->active[slot] = 0;
+			ikDisconLink_reply(w->link, slot, -1, "OpenDiscon avrSWAP map uses records beyond those sent to the controller server");
+			return;
+		}
+	}
+	if (!w->active[slot]) {
+		ikDisconLink_reply(w->link, slot, -1, "OpenDiscon controller not initialised");
+		return;
+	}
+	
+	ikClwindconTurbine_step(turbine, data);
+	
+	if (NINT(data[0]) == -1) {
+		ikClwindconTurbine_close(turbine);
+		w->active[slot] = 0;
+	}
+	ikDisconLink_reply(w->link, slot, 0, NULL);
+}
+
+static void *work(void *arg) {
+	worker *w = (worker *) arg;
+	unsigned int doorbell;
+	int busy;
+	int i;
+	
+	/* decaying filter states would otherwise become denormal and slow */
+	SET_FTZ_DAZ();
+	
+	while (!stop) {
+		doorbell = ikDisconLink_getDoorbell(w->link);
+		busy = 0;
+		for (i = w->first; i < w->nSlots; i += w->stride) {
+			if (ikDisconLink_isPending(w->link, i)) {
+				serve(w, i);
+				busy = 1;
+			}
+		}
+		if (!busy) ikDisconLink_waitDoorbell(w->link, doorbell, WAIT);
+	}
+	
+	return NULL;
+}
+
+int main(int argc, char *argv[]) {
+	ikDisconLink link;
+	ikDisconLinkParams params;
+	ikClwindconTurbine *turbines;
+	int *active;
+	worker *workers;
+	int nThreads = 1;
+	int i;
+	
+	/* create the link */
+	ikDisconLink_initParams(&params);
+	params.create = 1;
+	if (1 < argc) params.nSlots = atoi(argv[1]);
+	if (2 < argc) nThreads = atoi(argv[2]);
+	if (3 < argc) params.name = argv[3];
+	if (0 >= nThreads) nThreads = 1;
+	if (ikDisconLink_init(&link, &params)) {
+		fprintf(stderr, "Cannot create controller server link %s: another server may be using it, or a crashed one may have left it behind\n", params.name);
+		return 1;
+	}
+	
+	turbines = (ikClwindconTurbine *) calloc(params.nSlots, sizeof(ikClwindconTurbine));
+	active = (int *) calloc(params.nSlots, sizeof(int));
+	workers = (worker *) calloc(nThreads, sizeof(worker));
+	if (NULL == turbines || NULL == active || NULL == workers) {
+		fprintf(stderr, "Not enough memory for %d turbines\n", params.nSlots);
+		ikDisconLink_close(&link);
+		return 1;
+	}
+	
+	signal(SIGINT, onSignal);
+	signal(SIGTERM, onSignal);
+	
+	/* start the workers, each with its share of the slots */
+	for (i = 0; i < nThreads; i++) {
+		workers[i].link = &link;
+		workers[i].turbines = turbines;
+		workers[i].active = active;
+		workers[i].first = i;
+		workers[i].stride = nThreads;
+		workers[i].nSlots = params.nSlots;
+		pthread_create(&(workers[i].thread), NULL, work, workers + i);
+	}
+	printf("Controller server %s serving %d turbines with %d threads\n", params.name, params.nSlots, nThreads);
+	fflush(stdout);
+	
+	for (i = 0; i < nThreads; i++) pthread_join(workers[i].thread, NULL);
+	
+	/* close the logs of unfinished simulations */
+	for (i = 0; i < params.nSlots; i++) {
+		if (active[i]) ikClwindconTurbine_close(turbines + i);
+	}
+	ikDisconLink_close(&link);
+	free(workers);
+	free(active);
+	free(turbines);
+	
+	return 0;
+}
@@ -0,0 +1,216 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconStatistics.c
+ * 
+ * @brief Class ikClwindconStatistics implementation
+ */
+
+#include "ikClwindconStatistics.h"
+
+/* @cond */
+
+/* start a new window */
+static void ikClwindconStatistics_reset(ikClwindconStatistics *self) {
+	int i;
+	int j;
+	
+	self->windowStart = self->steps;
+	for (i = 0; i < self->n; i++) {
+		ikStats_init(self->stats + i);
+	}
+	for (i = 0; i < self->nStates; i++) {
+		for (j = 0; j < self->nValues[i]; j++) {
+			self->counts[i][j] = 0;
+		}
+	}
+}
+
+/* @endcond */
+
+int ikClwindconStatistics_init(ikClwindconStatistics *self, const ikClwindconStatisticsParams *params, const ikClwindconWTCon *con, const ikAvrSwapMapField *fields, int nFields) {
+	int i;
+	int j;
+	int err;
+	
+	self->n = 0;
+	self->nStates = 0;
+	self->steps = 0;
+	
+	/* check the parameters */
+	if (0 > params->n || IKCLWINDCONSTATISTICS_MAXSIGNALS < params->n) return -1;
+	if (0 > params->nStates || IKCLWINDCONSTATISTICS_MAXSTATES < params->nStates) return -2;
+	for (i = 0; i < params->nStates; i++) {
+		if (1 > params->nValues[i] || IKCLWINDCONSTATISTICS_MAXVALUES < params->nValues[i]) return -3;
+	}
+	if (0.0 >= params->T) return -4;
+	if (params->T > params->window) return -5;
+	
+	/* register the parameters, with the state signals sampled after the others */
+	self->T = params->T;
+	self->windowSteps = (unsigned long) (params->window/params->T + 0.5);
+	for (i = 0; i < params->n; i++) {
+		self->names[i] = params->names[i];
+	}
+	for (i = 0; i < params->nStates; i++) {
+		self->names[params->n + i] = params->stateNames[i];
+		self->nValues[i] = params->nValues[i];
+		for (j = 0; j < self->nValues[i]; j++) {
+			self->values[i][j] = params->values[i][j];
+		}
+	}
+	err = ikClwindconProbe_init(&(self->probe), params->n + params->nStates, self->names, con, fields, nFields);
+	self->n = params->n;
+	self->nStates = params->nStates;
+	
+	ikClwindconStatistics_reset(self);
+	
+	return err ? -6 : 0;
+}
+
+void ikClwindconStatistics_initParams(ikClwindconStatisticsParams *params) {
+	/* aggregate nothing */
+	params->n = 0;
+	params->nStates = 0;
+	params->T = 0.01;
+	params->window = 600.0;
+}
+
+void ikClwindconStatisticsSignals(ikClwindconStatisticsParams *params) {
+	int i;
+	int j;
+	
+	/*! [Statistics signals] */
+	/*
+	####################################################################
+	                    Statistics signals
+
+	The following signals, named either as the variables of the avrSWAP
+	map or as accepted by ikClwindconWTCon_getOutput, are aggregated
+	over consecutive windows of the given duration. Their mean, standard
+	deviation, minimum and maximum, and the time the state signals
+	spend at each of the given values, are written as one line per
+	window to file statistics.txt, if switched on (on = 1; off by
+	default).
+
+	Set parameters here:
+	*/
+	const int on = 0; /* [-] */
+	const double window = 600.0; /* [s] */
+	static const char *names[] = {
+		"generatorSpeed",
+		"generator speed equivalent",
+		"rotorSpeed",
+		"measuredTorque",
+		"torqueDemand",
+		"measuredPitch",
+		"collective pitch demand",
+		"yawError",
+		"deratingRatio",
+		"blade1OutOfPlaneMoment",
+		"individual pitch control>My",
+		"individual pitch control>Mz",
+	};
+	static const struct {
+		const char *name;
+		int n;
+		double values[IKCLWINDCONSTATISTICS_MAXVALUES];
+	} states[] = {
+		{"torque-pitch manager>state", 2, {0.0, 1.0}},
+		{"speed sensor manager>status", 5, {0.0, -1.0, -2.0, -3.0, 4.0}},
+	};
+	/*
+	####################################################################
+	*/
+	/*! [Statistics signals] */
+	
+	params->window = window;
+	params->n = on ? sizeof(names)/sizeof(names[0]) : 0;
+	for (i = 0; i < params->n; i++) {
+		params->names[i] = names[i];
+	}
+	params->nStates = on ? sizeof(states)/sizeof(states[0]) : 0;
+	for (i = 0; i < params->nStates; i++) {
+		params->stateNames[i] = states[i].name;
+		params->nValues[i] = states[i].n;
+		for (j = 0; j < states[i].n; j++) {
+			params->values[i][j] = states[i].values[j];
+		}
+	}
+}
+
+int ikClwindconStatistics_step(ikClwindconStatistics *self, const ikClwindconWTCon *con) {
+	int i;
+	int j;
+	const double *state;
+	
+	if (0 == self->n + self->nStates) return 0;
+	
+	/* the previous window is complete, start a new one */
+	if (self->steps - self->windowStart >= self->windowSteps) ikClwindconStatistics_reset(self);
+	self->steps++;
+	
+	ikClwindconProbe_sample(&(self->probe), con, self->samples);
+	for (i = 0; i < self->n; i++) {
+		ikStats_step(self->stats + i, self->samples[i]);
+	}
+	state = self->samples + self->n;
+	for (i = 0; i < self->nStates; i++) {
+		for (j = 0; j < self->nValues[i]; j++) {
+			if (state[i] == self->values[i][j]) {
+				self->counts[i][j]++;
+				break;
+			}
+		}
+	}
+	
+	return self->steps - self->windowStart >= self->windowSteps;
+}
+
+void ikClwindconStatistics_writeHeader(const ikClwindconStatistics *self, FILE *f) {
+	int i;
+	int j;
+	
+	fprintf(f, "# end time [s]\tduration [s]");
+	for (i = 0; i < self->n; i++) {
+		fprintf(f, "\t%s mean\t%s std\t%s min\t%s max", self->names[i], self->names[i], self->names[i], self->names[i]);
+	}
+	for (i = 0; i < self->nStates; i++) {
+		for (j = 0; j < self->nValues[i]; j++) {
+			fprintf(f, "\t%s = %g [s]", self->names[self->n + i], self->values[i][j]);
+		}
+	}
+	fprintf(f, "\n");
+}
+
+void ikClwindconStatistics_writeRecord(const ikClwindconStatistics *self, FILE *f) {
+	int i;
+	int j;
+	
+	fprintf(f, "%.9g\t%.9g", self->steps*self->T, (self->steps - self->windowStart)*self->T);
+	for (i = 0; i < self->n; i++) {
+		fprintf(f, "\t%.9g\t%.9g\t%.9g\t%.9g", ikStats_getMean(self->stats + i), ikStats_getStd(self->stats + i), ikStats_getMin(self->stats + i), ikStats_getMax(self->stats + i));
+	}
+	for (i = 0; i < self->nStates; i++) {
+		for (j = 0; j < self->nValues[i]; j++) {
+			fprintf(f, "\t%.9g", self->counts[i][j]*self->T);
+		}
+	}
+	fprintf(f, "\n");
+}
@@ -0,0 +1,160 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconStatistics.h
+ * 
+ * @brief Class ikClwindconStatistics interface
+ */
+
+#ifndef IKCLWINDCONSTATISTICS_H
+#define IKCLWINDCONSTATISTICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include "ikClwindconProbe.h"
+#include "ikStats.h"
+
+#define IKCLWINDCONSTATISTICS_MAXSIGNALS 16
+#define IKCLWINDCONSTATISTICS_MAXSTATES 4
+#define IKCLWINDCONSTATISTICS_MAXVALUES 8
+
+    /**
+     * @struct ikClwindconStatistics
+     * @brief Windowed statistics, SCADA style
+     * 
+     * This aggregates signals of an @link ikClwindconWTCon @endlink instance, as sampled
+     * by an @link ikClwindconProbe @endlink, over consecutive windows of a given duration,
+     * e.g. 10 minutes. It records the mean, standard deviation, minimum and maximum of each
+     * signal, with an @link ikStats @endlink instance each, and the time each state signal,
+     * e.g. a state machine state or status code, spends at each of a list of values.
+     * 
+     * @link ikClwindconStatistics_step @endlink tells when a window is complete, and its
+     * record can then be written, as a single line, with
+     * @link ikClwindconStatistics_writeRecord @endlink, until the next step starts a new
+     * window.
+     * 
+     * @par Inputs
+     * @li controller: controller instance, specify via @link ikClwindconStatistics_step @endlink
+     * 
+     * @par Outputs
+     * @li records, get via @link ikClwindconStatistics_writeRecord @endlink
+     * 
+     * @par Methods
+     * @li @link ikClwindconStatistics_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikClwindconStatistics_init @endlink initialise an instance
+     * @li @link ikClwindconStatistics_step @endlink execute periodic calculations
+     * @li @link ikClwindconStatistics_writeHeader @endlink write the column names of the records
+     * @li @link ikClwindconStatistics_writeRecord @endlink write the record of the current window
+     */
+    typedef struct ikClwindconStatistics {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int n;
+        int nStates;
+        const char *names[IKCLWINDCONSTATISTICS_MAXSIGNALS + IKCLWINDCONSTATISTICS_MAXSTATES];
+        int nValues[IKCLWINDCONSTATISTICS_MAXSTATES];
+        double values[IKCLWINDCONSTATISTICS_MAXSTATES][IKCLWINDCONSTATISTICS_MAXVALUES];
+        ikClwindconProbe probe;
+        ikStats stats[IKCLWINDCONSTATISTICS_MAXSIGNALS];
+        unsigned long counts[IKCLWINDCONSTATISTICS_MAXSTATES][IKCLWINDCONSTATISTICS_MAXVALUES];
+        double samples[IKCLWINDCONSTATISTICS_MAXSIGNALS + IKCLWINDCONSTATISTICS_MAXSTATES];
+        double T;
+        unsigned long windowSteps;
+        unsigned long steps;
+        unsigned long windowStart;
+        /* @endcond */
+    } ikClwindconStatistics;
+
+    /**
+     * @struct ikClwindconStatisticsParams
+     * @brief Windowed statistics initialisation parameters
+     */
+    typedef struct ikClwindconStatisticsParams {
+        int n; /**<number of signals. The default value is 0.*/
+        const char *names[IKCLWINDCONSTATISTICS_MAXSIGNALS]; /**<signal names, as for @link ikClwindconProbe_init @endlink. They must outlive the instance.*/
+        int nStates; /**<number of state signals. The default value is 0.*/
+        const char *stateNames[IKCLWINDCONSTATISTICS_MAXSTATES]; /**<state signal names, as for @link ikClwindconProbe_init @endlink. They must outlive the instance.*/
+        int nValues[IKCLWINDCONSTATISTICS_MAXSTATES]; /**<number of values of each state signal*/
+        double values[IKCLWINDCONSTATISTICS_MAXSTATES][IKCLWINDCONSTATISTICS_MAXVALUES]; /**<values of each state signal*/
+        double T; /**<sampling interval in s. The default value is 0.01.*/
+        double window; /**<window duration in s. The default value is 600.0.*/
+    } ikClwindconStatisticsParams;
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param params initialisation parameters
+     * @param con controller instance
+     * @param fields named controller variables, which must outlive the instance
+     * @param nFields number of named controller variables
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of signals, must be between 0 and IKCLWINDCONSTATISTICS_MAXSIGNALS
+     * @li -2: invalid number of state signals, must be between 0 and IKCLWINDCONSTATISTICS_MAXSTATES
+     * @li -3: invalid number of state signal values, must be between 1 and IKCLWINDCONSTATISTICS_MAXVALUES
+     * @li -4: invalid sampling interval, must be positive
+     * @li -5: invalid window duration, must be at least the sampling interval
+     * @li -6: unknown signal name, the signal is sampled as 0
+     */
+    int ikClwindconStatistics_init(ikClwindconStatistics *self, const ikClwindconStatisticsParams *params, const ikClwindconWTCon *con, const ikAvrSwapMapField *fields, int nFields);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikClwindconStatistics_initParams(ikClwindconStatisticsParams *params);
+
+    /**
+     * Set the list of signals aggregated for CL-Windcon
+     * @param params initialisation parameter structure
+     */
+    void ikClwindconStatisticsSignals(ikClwindconStatisticsParams *params);
+
+    /**
+     * Execute periodic calculations
+     * @param self instance
+     * @param con controller instance, after its step
+     * @return 1 if the window is complete, 0 otherwise
+     */
+    int ikClwindconStatistics_step(ikClwindconStatistics *self, const ikClwindconWTCon *con);
+
+    /**
+     * Write the column names of the records, as a comment line
+     * @param self instance
+     * @param f file to write to
+     */
+    void ikClwindconStatistics_writeHeader(const ikClwindconStatistics *self, FILE *f);
+
+    /**
+     * Write the record of the current window, complete or not, as a line
+     * @param self instance
+     * @param f file to write to
+     */
+    void ikClwindconStatistics_writeRecord(const ikClwindconStatistics *self, FILE *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKCLWINDCONSTATISTICS_H */
@@ -0,0 +1,162 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file ikClwindconSupercon.c
+ *
+ * @brief CL-Windcon wind turbine controller supercontroller interface
+ */
+
+#include <stdlib.h>
+#include "ikClwindconSupercon.h"
+
+void ikClwindconSupercon_initState(ikClwindconSuperconState *state, int turbine) {
+	state->turbine = turbine;
+	state->open = 0;
+	state->retry = 0;
+	state->stale = 0;
+	state->received = 0;
+}
+
+void ikClwindconSupercon_closeState(ikClwindconSuperconState *state) {
+	if (state->open) ikSuperconChannel_close(&(state->channel));
+	state->open = 0;
+}
+
+/* finite, i.e. neither infinite nor NaN */
+static int ikClwindconSupercon_isFinite(double x) {
+	return x - x == 0.0;
+}
+
+/* whether a message is usable as controller inputs, its limits finite and consistent */
+static int ikClwindconSupercon_isValid(const ikSuperconMessage *message) {
+	if (!(0.0 <= message->deratingRatio && message->deratingRatio <= 1.0)) return 0;
+	if (!ikClwindconSupercon_isFinite(message->externalMaximumTorque)) return 0;
+	if (!ikClwindconSupercon_isFinite(message->externalMinimumTorque)) return 0;
+	if (!ikClwindconSupercon_isFinite(message->externalMaximumPitch)) return 0;
+	if (!ikClwindconSupercon_isFinite(message->externalMinimumPitch)) return 0;
+	if (!ikClwindconSupercon_isFinite(message->yawErrorReference)) return 0;
+	if (message->externalMinimumTorque > message->externalMaximumTorque) return 0;
+	if (message->externalMinimumPitch > message->externalMaximumPitch) return 0;
+	return 1;
+}
+
+void ikClwindconSupercon(ikClwindconSuperconState *state, ikClwindconWTConInputs *in) {
+	ikSuperconChannelParams channelParams;
+	ikSuperconMessage message;
+	const char *env;
+	int stale;
+
+	/*! [Supercontroller] */
+	/*
+	####################################################################
+	                    Supercontroller
+
+	Wind farm level inputs. Replace this function to plug in a
+	supercontroller, e.g. one implementing a farm derating strategy or
+	wake steering by means of the yaw error reference.
+
+	The inputs are read from the shared memory supercontroller channel
+	called channelName (empty to disable), as turbine number turbine,
+	unless environment variable OPENDISCON_TURBINE gives another. If
+	no new message arrives for maxAge sampling intervals, the last
+	message is held if holdLast is not 0, and the default values below
+	are used otherwise, as by default. A channel which cannot be opened
+	is tried again every retryInterval sampling intervals, using the
+	default values meanwhile, and one which stays stale for
+	retryInterval sampling intervals is closed and opened anew, in case
+	the supercontroller has been restarted. A message with a value
+	which is not finite, a derating ratio outside [0, 1], or a minimum
+	limit above its maximum is ignored as if stale.
+
+	Set parameters here:
+	*/
+	const double deratingRatio = 0.2; /* [-] */
+	const double maxTorque = 230.0; /* [kNm] */
+	const double minTorque = 0.0; /* [kNm] */
+	const double maxPitch = 90.0; /* [deg] */
+	const double minPitch = 0.0; /* [deg] */
+	const double yawErrorReference = 0.0; /* [deg] */
+	const char *channelName = "OpenDisconSupercon";
+	const int turbine = 0;
+	const int maxAge = 1000;
+	const int holdLast = 0;
+	const int retryInterval = 1000;
+	/*
+	####################################################################
+	*/
+	/*! [Supercontroller] */
+
+	in->deratingRatio = deratingRatio;
+	in->externalMaximumTorque = maxTorque;
+	in->externalMinimumTorque = minTorque;
+	in->externalMaximumPitch = maxPitch;
+	in->externalMinimumPitch = minPitch;
+	in->yawErrorReference = yawErrorReference;
+
+	if ('\0' == channelName[0]) return;
+
+	/* open the channel, or try again later */
+	if (!state->open) {
+		if (0 < state->retry) {
+			state->retry--;
+			return;
+		}
+		ikSuperconChannel_initParams(&channelParams);
+		channelParams.name = channelName;
+		channelParams.turbine = turbine;
+		env = getenv("OPENDISCON_TURBINE");
+		if (NULL != env) channelParams.turbine = atoi(env);
+		if (0 <= state->turbine) channelParams.turbine = state->turbine;
+		channelParams.maxAge = maxAge;
+		if (ikSuperconChannel_init(&(state->channel), &channelParams)) {
+			state->retry = retryInterval;
+			return;
+		}
+		state->open = 1;
+	}
+
+	/* read the latest message, falling back if stale */
+	stale = ikSuperconChannel_read(&(state->channel), &message);
+	if (0 > stale && retryInterval <= ++state->stale) {
+		/* a restarted supercontroller publishes on a new channel */
+		ikClwindconSupercon_closeState(state);
+		state->stale = 0;
+	} else if (0 <= stale) {
+		state->stale = 0;
+	}
+	if (0 == stale && ikClwindconSupercon_isValid(&message)) {
+		state->last = message;
+		state->received = 1;
+	} else if (0 == stale && !holdLast) {
+		/* an invalid message stands for none, until a valid one arrives */
+		state->received = 0;
+	} else if (0 > stale && !(holdLast && state->received)) {
+		return;
+	}
+	if (!state->received) return;
+
+	in->deratingRatio = state->last.deratingRatio;
+	in->externalMaximumTorque = state->last.externalMaximumTorque;
+	in->externalMinimumTorque = state->last.externalMinimumTorque;
+	in->externalMaximumPitch = state->last.externalMaximumPitch;
+	in->externalMinimumPitch = state->last.externalMinimumPitch;
+	in->yawErrorReference = state->last.yawErrorReference;
+
+}
@@ -0,0 +1,79 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file ikClwindconSupercon.h
+ * 
+ * @brief CL-Windcon wind turbine controller supercontroller interface
+ */
+
+#ifndef IKCLWINDCONSUPERCON_H
+#define IKCLWINDCONSUPERCON_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ikClwindconWTCon.h"  
+#include "ikSuperconChannel.h"
+
+	/**
+	 * @struct ikClwindconSuperconState
+	 * @brief Supercontroller interface state of a turbine
+	 */
+	typedef struct ikClwindconSuperconState {
+		/* @cond */
+		int turbine;
+		ikSuperconChannel channel;
+		int open;
+		int retry;
+		int stale;
+		int received;
+		ikSuperconMessage last;
+		/* @endcond */
+	} ikClwindconSuperconState;
+
+	/**
+	 * Initialise the supercontroller interface state of a turbine
+	 * @param state supercontroller interface state
+	 * @param turbine turbine index in the supercontroller channel, or -1 to use the configured one,
+	 * or that given by environment variable OPENDISCON_TURBINE
+	 */
+	void ikClwindconSupercon_initState(ikClwindconSuperconState *state, int turbine);
+
+	/**
+	 * Close the supercontroller channel of a turbine, if open
+	 * @param state supercontroller interface state
+	 */
+	void ikClwindconSupercon_closeState(ikClwindconSuperconState *state);
+
+	/**
+	 * Set the controller inputs which are decided at wind farm level, i.e.
+	 * the derating ratio, the external torque and pitch limits and the yaw
+	 * error reference.
+	 * @param state supercontroller interface state
+	 * @param in controller inputs
+	 */
+	void ikClwindconSupercon(ikClwindconSuperconState *state, ikClwindconWTConInputs *in);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKCLWINDCONSUPERCON_H */
@@ -0,0 +1,129 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconTelemetry.c
+ * 
+ * @brief Class ikClwindconTelemetry implementation
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "ikClwindconTelemetry.h"
+
+int ikClwindconTelemetry_init(ikClwindconTelemetry *self, const ikClwindconTelemetryParams *params, const ikClwindconWTCon *con, const ikAvrSwapMapField *fields, int nFields) {
+	int i;
+	int err;
+	
+	self->board.memory.address = NULL;
+	self->n = 0;
+	self->steps = 0;
+	
+	if (0 >= params->decimation) return -1;
+	self->decimation = params->decimation;
+	self->countdown = 0;
+	
+	/* no board name, no telemetry */
+	if (NULL == params->board.name) return 0;
+	
+	if (ikTelemetryBoard_init(&(self->board), &(params->board))) return -2;
+	err = ikClwindconProbe_init(&(self->probe), params->board.n, params->board.names, con, fields, nFields);
+	self->n = params->board.n;
+	for (i = 0; i < self->n; i++) {
+		self->values[i] = 0.0;
+	}
+	
+	return err ? -3 : 0;
+}
+
+void ikClwindconTelemetry_initParams(ikClwindconTelemetryParams *params) {
+	/* publish nothing */
+	ikTelemetryBoard_initParams(&(params->board));
+	params->board.name = NULL;
+	params->decimation = 1;
+}
+
+void ikClwindconTelemetrySignals(ikClwindconTelemetryParams *params, const char *suffix) {
+	int i;
+	
+	/*! [Telemetry signals] */
+	/*
+	####################################################################
+	                    Telemetry signals
+
+	The following signals, named either as the variables of the avrSWAP
+	map, including the harmonic amplitudes if the harmonic monitors are
+	on, or as accepted by ikClwindconWTCon_getOutput, are published
+	every N sampling intervals on the shared memory telemetry board
+	called name, to which the turbine index is appended when the
+	controller server hosts several turbines (empty name to disable, as
+	by default). Each board has a single writer, so a name can only be
+	used by one simulation at a time: give concurrent simulations
+	different names, or run them through the controller server.
+
+	Set parameters here:
+	*/
+	const char *name = "";
+	const int N = 10;
+	static const char *names[] = {
+		"generator speed equivalent",
+		"torque demand from torque control",
+		"minimum torque",
+		"maximum torque",
+		"collective pitch demand",
+		"minimum pitch",
+		"maximum pitch",
+		"torque-pitch manager>state",
+		"speed sensor manager>ok 1",
+		"speed sensor manager>ok 2",
+		"speed sensor manager>ok 3",
+		"individual pitch control>My",
+		"individual pitch control>Mz",
+		"individual pitch for yaw",
+		"power manager>cache hit rate",
+	};
+	/*
+	####################################################################
+	*/
+	/*! [Telemetry signals] */
+	
+	params->decimation = N;
+	params->board.name = NULL;
+	if ('\0' == name[0] || IKSHAREDMEMORY_MAXNAME <= strlen(name) + strlen(suffix) + 1) return;
+	sprintf(params->boardName, "%s%s", name, suffix);
+	params->board.name = params->boardName;
+	params->board.n = sizeof(names)/sizeof(names[0]);
+	for (i = 0; i < params->board.n; i++) {
+		params->board.names[i] = names[i];
+	}
+}
+
+void ikClwindconTelemetry_step(ikClwindconTelemetry *self, const ikClwindconWTCon *con) {
+	self->steps++;
+	if (0 == self->n) return;
+	if (0 < self->countdown--) return;
+	self->countdown = self->decimation - 1;
+	
+	ikClwindconProbe_sample(&(self->probe), con, self->values);
+	ikTelemetryBoard_write(&(self->board), self->steps, self->values);
+}
+
+void ikClwindconTelemetry_close(ikClwindconTelemetry *self) {
+	ikTelemetryBoard_close(&(self->board));
+	self->n = 0;
+}
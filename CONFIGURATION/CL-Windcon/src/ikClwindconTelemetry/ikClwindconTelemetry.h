@@ -0,0 +1,122 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconTelemetry.h
+ * 
+ * @brief Class ikClwindconTelemetry interface
+ */
+
+#ifndef IKCLWINDCONTELEMETRY_H
+#define IKCLWINDCONTELEMETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ikClwindconProbe.h"
+#include "ikTelemetryBoard.h"
+
+    /**
+     * @struct ikClwindconTelemetry
+     * @brief Live telemetry
+     * 
+     * This publishes a list of signals of an @link ikClwindconWTCon @endlink instance,
+     * as sampled by an @link ikClwindconProbe @endlink, on an
+     * @link ikTelemetryBoard @endlink, at the end of every given number of steps.
+     * 
+     * @par Inputs
+     * @li controller: controller instance, specify via @link ikClwindconTelemetry_step @endlink
+     * 
+     * @par Methods
+     * @li @link ikClwindconTelemetry_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikClwindconTelemetry_init @endlink initialise an instance
+     * @li @link ikClwindconTelemetry_step @endlink execute periodic calculations
+     * @li @link ikClwindconTelemetry_close @endlink close the telemetry board
+     */
+    typedef struct ikClwindconTelemetry {
+        /**
+         * Private members
+         */
+        /* @cond */
+        ikTelemetryBoard board;
+        int n;
+        ikClwindconProbe probe;
+        double values[IKTELEMETRYBOARD_MAXSIGNALS];
+        int decimation;
+        int countdown;
+        unsigned long steps;
+        /* @endcond */
+    } ikClwindconTelemetry;
+
+    /**
+     * @struct ikClwindconTelemetryParams
+     * @brief Live telemetry initialisation parameters
+     */
+    typedef struct ikClwindconTelemetryParams {
+        ikTelemetryBoardParams board; /**<telemetry board parameters, with the signal names as for @link ikClwindconProbe_init @endlink. Its name is NULL by default, which disables the telemetry. The signal names must outlive the instance.*/
+        int decimation; /**<number of steps between snapshots. The default value is 1.*/
+        char boardName[IKSHAREDMEMORY_MAXNAME]; /**<storage for the board name, if it needs to be built*/
+    } ikClwindconTelemetryParams;
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param params initialisation parameters
+     * @param con controller instance
+     * @param fields named controller variables, which must outlive the instance
+     * @param nFields number of named controller variables
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid decimation, must be positive
+     * @li -2: the telemetry board could not be created
+     * @li -3: unknown signal name, the signal is published as 0
+     */
+    int ikClwindconTelemetry_init(ikClwindconTelemetry *self, const ikClwindconTelemetryParams *params, const ikClwindconWTCon *con, const ikAvrSwapMapField *fields, int nFields);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikClwindconTelemetry_initParams(ikClwindconTelemetryParams *params);
+
+    /**
+     * Set the list of signals published for CL-Windcon, and the board name
+     * @param params initialisation parameter structure
+     * @param suffix suffix to the board name, e.g. to tell turbines apart
+     */
+    void ikClwindconTelemetrySignals(ikClwindconTelemetryParams *params, const char *suffix);
+
+    /**
+     * Execute periodic calculations
+     * @param self instance
+     * @param con controller instance, after its step
+     */
+    void ikClwindconTelemetry_step(ikClwindconTelemetry *self, const ikClwindconWTCon *con);
+
+    /**
+     * Close the telemetry board
+     * @param self instance
+     */
+    void ikClwindconTelemetry_close(ikClwindconTelemetry *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKCLWINDCONTELEMETRY_H */
@@ -0,0 +1,316 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconTurbine.c
+ * 
+ * @brief Class ikClwindconTurbine implementation
+ */
+
+#include <string.h>
+#include "ikClwindconTurbine.h"
+#include "ikClwindconInputMod.h"
+#include "ikClwindconWTConfig.h"
+#ifdef OPENDISCON_PROFILE_RANGES
+#include "ikClwindconFootprint.h"
+#endif
+
+/* @cond */
+
+#define NINT(a) ((a) >= 0.0 ? (int) ((a)+0.5) : ((a)-0.5))
+
+/* avrSWAP array conversions */
+#define PI 3.14159265358979
+#define DEG (180.0/PI) /* rad to deg */
+#define RPM (PI/30.0) /* rpm to rad/s */
+#define UNLIMITED 1.0e300
+
+static void setAvrSwapMap(ikAvrSwapMap *map, ikClwindconWTCon *con, double *measuredPitch, double *measuredTorque) {
+	int i;
+	
+	/*! [avrSWAP map] */
+	/*
+	####################################################################
+	                    avrSWAP map
+
+	Controller inputs are read from the avrSWAP array as
+	scale*avrSWAP[index] + offset, or as offset if index is -1, and
+	outputs are written to it as scale*output + offset, all limited to
+	[min, max]. Indices start from 0, i.e. avrSWAP record n is index n-1.
+
+	These conversions can be replaced, variable by variable, with lines
+	in the controller parameter file (INFILE) of the form
+
+	in|out index name scale offset [min max]
+
+	with name as listed in function setFields.
+
+	Set parameters here:
+	*/
+	ikAvrSwapMap_setInput(map, &(con->in.generatorSpeed), 19, 1.0, 0.0, -UNLIMITED, UNLIMITED); /* rad/s */
+	ikAvrSwapMap_setInput(map, &(con->in.rotorSpeed), 20, 1.0, 0.0, -UNLIMITED, UNLIMITED); /* rad/s */
+	ikAvrSwapMap_setInput(map, &(con->in.maximumSpeed), -1, 0.0, 480.0*RPM, -UNLIMITED, UNLIMITED); /* rpm to rad/s */
+	ikAvrSwapMap_setInput(map, &(con->in.azimuth), 59, DEG, 0.0, -UNLIMITED, UNLIMITED); /* rad to deg */
+	ikAvrSwapMap_setInput(map, &(con->in.maximumIndividualPitch), -1, 0.0, 10.0, -UNLIMITED, UNLIMITED); /* deg */
+	ikAvrSwapMap_setInput(map, &(con->in.yawError), 23, DEG, 0.0, -UNLIMITED, UNLIMITED); /* rad to deg */
+	for (i = 0; i < 3; i++) {
+		ikAvrSwapMap_setInput(map, &(con->in.bladeRootMoments[i].c[0]), 68 + i, 1.0e-3, 0.0, -UNLIMITED, UNLIMITED); /* Nm to kNm */
+		ikAvrSwapMap_setInput(map, &(con->in.bladeRootMoments[i].c[1]), 29 + i, 1.0e-3, 0.0, -UNLIMITED, UNLIMITED); /* Nm to kNm */
+	}
+	ikAvrSwapMap_setInput(map, measuredPitch, 3, DEG, 0.0, -UNLIMITED, UNLIMITED); /* rad to deg */
+	ikAvrSwapMap_setInput(map, measuredTorque, 22, 1.0e-3, 0.0, -UNLIMITED, UNLIMITED); /* Nm to kNm */
+	
+	ikAvrSwapMap_setOutput(map, &(con->out.torqueDemand), 46, 1.0e3, 0.0, -UNLIMITED, UNLIMITED); /* kNm to Nm */
+	ikAvrSwapMap_setOutput(map, &(con->out.pitchDemandBlade1), 41, 1.0/DEG, 0.0, -UNLIMITED, UNLIMITED); /* deg to rad */
+	ikAvrSwapMap_setOutput(map, &(con->out.pitchDemandBlade2), 42, 1.0/DEG, 0.0, -UNLIMITED, UNLIMITED); /* deg to rad */
+	ikAvrSwapMap_setOutput(map, &(con->out.pitchDemandBlade3), 43, 1.0/DEG, 0.0, -UNLIMITED, UNLIMITED); /* deg to rad */
+	ikAvrSwapMap_setOutput(map, &(con->out.collectivePitchDemand), 44, 1.0/DEG, 0.0, -UNLIMITED, UNLIMITED); /* deg to rad */
+	/*
+	####################################################################
+	*/
+	/*! [avrSWAP map] */
+}
+
+/* named variables, for the avrSWAP map file and the signal probes */
+static void setFields(ikClwindconTurbine *self) {
+	const ikAvrSwapMapField fields[IKCLWINDCONTURBINE_NFIELDS] = {
+		{"externalMaximumTorque", &(self->con.in.externalMaximumTorque)},
+		{"externalMinimumTorque", &(self->con.in.externalMinimumTorque)},
+		{"externalMaximumPitch", &(self->con.in.externalMaximumPitch)},
+		{"externalMinimumPitch", &(self->con.in.externalMinimumPitch)},
+		{"maximumSpeed", &(self->con.in.maximumSpeed)},
+		{"generatorSpeed", &(self->con.in.generatorSpeed)},
+		{"rotorSpeed", &(self->con.in.rotorSpeed)},
+		{"deratingRatio", &(self->con.in.deratingRatio)},
+		{"azimuth", &(self->con.in.azimuth)},
+		{"blade1InPlaneMoment", &(self->con.in.bladeRootMoments[0].c[0])},
+		{"blade1OutOfPlaneMoment", &(self->con.in.bladeRootMoments[0].c[1])},
+		{"blade2InPlaneMoment", &(self->con.in.bladeRootMoments[1].c[0])},
+		{"blade2OutOfPlaneMoment", &(self->con.in.bladeRootMoments[1].c[1])},
+		{"blade3InPlaneMoment", &(self->con.in.bladeRootMoments[2].c[0])},
+		{"blade3OutOfPlaneMoment", &(self->con.in.bladeRootMoments[2].c[1])},
+		{"maximumIndividualPitch", &(self->con.in.maximumIndividualPitch)},
+		{"yawErrorReference", &(self->con.in.yawErrorReference)},
+		{"yawError", &(self->con.in.yawError)},
+		{"measuredPitch", &(self->measuredPitch)},
+		{"measuredTorque", &(self->measuredTorque)},
+		{"torqueDemand", &(self->con.out.torqueDemand)},
+		{"pitchDemandBlade1", &(self->con.out.pitchDemandBlade1)},
+		{"pitchDemandBlade2", &(self->con.out.pitchDemandBlade2)},
+		{"pitchDemandBlade3", &(self->con.out.pitchDemandBlade3)},
+		{"collectivePitchDemand", &(self->con.out.collectivePitchDemand)},
+	};
+	int i;
+	
+	for (i = 0; i < IKCLWINDCONTURBINE_NFIELDS; i++) {
+		self->fields[i] = fields[i];
+	}
+	self->nFields = IKCLWINDCONTURBINE_NFIELDS;
+}
+
+/* @endcond */
+
+int ikClwindconTurbine_init(ikClwindconTurbine *self, double T, const char *inFile, const char *suffix, int turbine) {
+	int err;
+	int mapErr;
+	ikClwindconWTConParams param;
+	ikClwindconTelemetryParams telemetryParam;
+	ikClwindconFatigueParams fatigueParam;
+	ikClwindconStatisticsParams statisticsParam;
+	ikClwindconHarmonicsParams harmonicsParam;
+	char logName[64];
+#ifdef OPENDISCON_PROFILE_RANGES
+	ikClwindconRangeProfilerParams profilerParam;
+	FILE *footprintFile;
+#endif
+	
+	/* nothing to close yet, should the initialisation stop early */
+	self->log = NULL;
+	self->statisticsFile = NULL;
+	ikClwindconSupercon_initState(&(self->supercon), turbine);
+	
+	ikClwindconWTCon_initParams(&param);
+	/* tune for the communication interval, if given */
+	if (0.0 >= T) T = getSamplingInterval();
+	setParamsForInterval(&param, T);
+	err = ikClwindconWTCon_init(&(self->con), &param);
+	if (err) return -1;
+	self->measuredPitch = 0.0;
+	self->measuredTorque = 0.0;
+	self->step = 0;
+	
+	/* set up the avrSWAP conversions, and replace them with those in the parameter file, if any */
+	ikAvrSwapMap_init(&(self->map));
+	setAvrSwapMap(&(self->map), &(self->con), &(self->measuredPitch), &(self->measuredTorque));
+	setFields(self);
+	/* a missing file leaves the map as set in code, but a half-applied one is an error */
+	mapErr = -2 == ikAvrSwapMap_load(&(self->map), inFile, self->fields, IKCLWINDCONTURBINE_NFIELDS);
+	
+#ifdef OPENDISCON_PROFILE_RANGES
+	ikClwindconRangeProfiler_initParams(&profilerParam);
+	ikClwindconRangeSignals(&profilerParam);
+	ikClwindconRangeProfiler_init(&(self->profiler), &profilerParam);
+	footprintFile = fopen("footprint.txt", "w");
+	if (NULL != footprintFile) {
+		ikClwindconFootprint(footprintFile);
+		fclose(footprintFile);
+	}
+#endif
+	
+	/* the harmonic amplitudes are named variables too, for the others */
+	ikClwindconHarmonics_initParams(&harmonicsParam);
+	ikClwindconHarmonicSignals(&harmonicsParam);
+	harmonicsParam.monitor.T = T;
+	err = ikClwindconHarmonics_init(&(self->harmonics), &harmonicsParam, &(self->con), self->fields, self->nFields) ? -6 : 0;
+	self->nFields += ikClwindconHarmonics_getFields(&(self->harmonics), self->fields + self->nFields, IKCLWINDCONHARMONICS_MAXOUTPUTS);
+	
+	ikClwindconTelemetry_initParams(&telemetryParam);
+	ikClwindconTelemetrySignals(&telemetryParam, suffix);
+	if (ikClwindconTelemetry_init(&(self->telemetry), &telemetryParam, &(self->con), self->fields, self->nFields)) err = -3;
+	
+	ikClwindconFatigue_initParams(&fatigueParam);
+	ikClwindconFatigueSignals(&fatigueParam);
+	fatigueParam.T = T;
+	if (ikClwindconFatigue_init(&(self->fatigue), &fatigueParam, &(self->con), self->fields, self->nFields)) err = -4;
+	
+	ikClwindconStatistics_initParams(&statisticsParam);
+	ikClwindconStatisticsSignals(&statisticsParam);
+	statisticsParam.T = T;
+	if (ikClwindconStatistics_init(&(self->statistics), &statisticsParam, &(self->con), self->fields, self->nFields)) err = -5;
+	
+	if (sizeof(logName) <= strlen(suffix) + 15) return -2;
+	sprintf(logName, "log%s.bin", suffix);
+	sprintf(self->fatigueName, "fatigue%s.txt", suffix);
+	self->log = fopen(logName, "wb");
+	if (NULL == self->log) return -2;
+	
+	/* nothing aggregated, no statistics file */
+	if (0 < statisticsParam.n + statisticsParam.nStates) {
+		sprintf(logName, "statistics%s.txt", suffix);
+		self->statisticsFile = fopen(logName, "w");
+		if (NULL == self->statisticsFile) return -2;
+		ikClwindconStatistics_writeHeader(&(self->statistics), self->statisticsFile);
+	}
+	
+	return mapErr ? -7 : err;
+}
+
+void ikClwindconTurbine_step(ikClwindconTurbine *self, float *data) {
+	int err;
+	double output = -12.0;
+#ifdef OPENDISCON_PROFILE_RANGES
+	FILE *rangeFile;
+#endif
+	
+	ikClwindconSupercon(&(self->supercon), &(self->con.in));
+	ikAvrSwapMap_gather(&(self->map), data);
+	
+	ikClwindconInputMod(&(self->con.in), self->step);
+	if (0 == self->step && getWarmStart()) {
+		/* start from the simulator's operating point, if so configured */
+		ikClwindconWTCon_warmStart(&(self->con), self->measuredPitch, self->measuredTorque);
+	}
+	ikClwindconWTCon_step(&(self->con));
+	self->step++;
+	
+	ikAvrSwapMap_scatter(&(self->map), data);
+	
+	if (NULL != self->log) {
+		err = ikClwindconWTCon_getOutput(&(self->con), &output, "individual pitch control>pitch y from control");
+		fwrite(&(output), 1, sizeof(output), self->log);
+		err = ikClwindconWTCon_getOutput(&(self->con), &output, "individual pitch control>pitch z from control");
+		fwrite(&(output), 1, sizeof(output), self->log);
+		err = ikClwindconWTCon_getOutput(&(self->con), &output, "individual pitch control>My");
+		fwrite(&(output), 1, sizeof(output), self->log);
+		err = ikClwindconWTCon_getOutput(&(self->con), &output, "individual pitch control>Mz");
+		fwrite(&(output), 1, sizeof(output), self->log);
+		err = ikClwindconWTCon_getOutput(&(self->con), &output, "individual pitch control>pitch increment 1");
+		fwrite(&(output), 1, sizeof(output), self->log);
+		err = ikClwindconWTCon_getOutput(&(self->con), &output, "individual pitch control>pitch increment 2");
+		fwrite(&(output), 1, sizeof(output), self->log);
+		err = ikClwindconWTCon_getOutput(&(self->con), &output, "individual pitch control>pitch increment 3");
+		fwrite(&(output), 1, sizeof(output), self->log);
+		err = ikClwindconWTCon_getOutput(&(self->con), &output, "generator speed equivalent");
+		fwrite(&(output), 1, sizeof(output), self->log);
+		err = ikClwindconWTCon_getOutput(&(self->con), &output, "speed sensor manager>signal 1");
+		fwrite(&(output), 1, sizeof(output), self->log);
+		err = ikClwindconWTCon_getOutput(&(self->con), &output, "speed sensor manager>signal 2");
+		fwrite(&(output), 1, sizeof(output), self->log);
+		err = ikClwindconWTCon_getOutput(&(self->con), &output, "speed sensor manager>signal 3");
+		fwrite(&(output), 1, sizeof(output), self->log);
+	}
+	
+	ikClwindconHarmonics_step(&(self->harmonics), &(self->con));
+	ikClwindconTelemetry_step(&(self->telemetry), &(self->con));
+	
+	/* a record per window, and one for the last, incomplete, window */
+	if ((ikClwindconStatistics_step(&(self->statistics), &(self->con)) || NINT(data[0]) == -1) && NULL != self->statisticsFile) {
+		ikClwindconStatistics_writeRecord(&(self->statistics), self->statisticsFile);
+		fflush(self->statisticsFile);
+	}
+	
+	ikClwindconFatigue_step(&(self->fatigue), &(self->con));
+	if (NINT(data[0]) == -1) ikClwindconTurbine_writeFatigue(self);
+	
+#ifdef OPENDISCON_PROFILE_RANGES
+	ikClwindconRangeProfiler_step(&(self->profiler), &(self->con));
+	if (NINT(data[0]) == -1) {
+		rangeFile = fopen("ranges.txt", "w");
+		if (NULL != rangeFile) {
+			ikClwindconRangeProfiler_write(&(self->profiler), rangeFile);
+			fclose(rangeFile);
+		}
+	}
+#endif
+}
+
+int ikClwindconTurbine_writeFatigue(const ikClwindconTurbine *self) {
+	FILE *f;
+	
+	/* nothing monitored, nothing to report */
+	if (0 == self->fatigue.n) return 0;
+	
+	f = fopen(self->fatigueName, "w");
+	if (NULL == f) return -1;
+	ikClwindconFatigue_write(&(self->fatigue), f);
+	fclose(f);
+	
+	return 0;
+}
+
+int ikClwindconTurbine_getSwapSize(const ikClwindconTurbine *self) {
+	return ikAvrSwapMap_getSize(&(self->map));
+}
+
+int ikClwindconTurbine_checkSwapSize(const ikClwindconTurbine *self, const float *data) {
+	int loggingStart = NINT(data[62]); /* record number of the first logging output */
+	
+	/* record 63 itself comes before the logging outputs, so anything else means it is not given */
+	if (63 >= loggingStart) return 0;
+	return ikAvrSwapMap_getSize(&(self->map)) >= loggingStart ? -1 : 0;
+}
+
+void ikClwindconTurbine_close(ikClwindconTurbine *self) {
+	ikClwindconWTCon_close(&(self->con));
+	if (NULL != self->log) fclose(self->log);
+	self->log = NULL;
+	if (NULL != self->statisticsFile) fclose(self->statisticsFile);
+	self->statisticsFile = NULL;
+	ikClwindconTelemetry_close(&(self->telemetry));
+	ikClwindconSupercon_closeState(&(self->supercon));
+}
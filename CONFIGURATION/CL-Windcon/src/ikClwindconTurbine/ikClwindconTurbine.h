@@ -0,0 +1,157 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikClwindconTurbine.h
+ * 
+ * @brief Class ikClwindconTurbine interface
+ */
+
+#ifndef IKCLWINDCONTURBINE_H
+#define IKCLWINDCONTURBINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include "ikClwindconWTCon.h"
+#include "ikClwindconSupercon.h"
+#include "ikAvrSwapMap.h"
+#include "ikClwindconTelemetry.h"
+#include "ikClwindconFatigue.h"
+#include "ikClwindconStatistics.h"
+#include "ikClwindconHarmonics.h"
+#ifdef OPENDISCON_PROFILE_RANGES
+#include "ikClwindconRangeProfiler.h"
+#endif
+
+#define IKCLWINDCONTURBINE_NFIELDS 25
+
+    /**
+     * @struct ikClwindconTurbine
+     * @brief CL-Windcon controller of a turbine, as seen through the DISCON interface
+     * 
+     * This holds everything the DISCON interface does for a turbine at each call:
+     * the controller, the avrSWAP map, the supercontroller interface state, the log,
+     * the rotor harmonic monitors, the live telemetry, the fatigue load monitor and the
+     * windowed statistics.
+     * The DISCON library has one, and the controller server one per turbine it hosts.
+     * 
+     * @par Methods
+     * @li @link ikClwindconTurbine_init @endlink initialise an instance, at the first call
+     * @li @link ikClwindconTurbine_checkSwapSize @endlink check the avrSWAP records used are before the logging outputs, at the first call
+     * @li @link ikClwindconTurbine_step @endlink execute a call
+     * @li @link ikClwindconTurbine_writeFatigue @endlink write the fatigue load report
+     * @li @link ikClwindconTurbine_close @endlink close the log, the statistics file, the telemetry board and the supercontroller channel, and free the controller
+     */
+    typedef struct ikClwindconTurbine {
+        /**
+         * Private members
+         */
+        /* @cond */
+        ikClwindconWTCon con;
+        ikAvrSwapMap map;
+        ikAvrSwapMapField fields[IKCLWINDCONTURBINE_NFIELDS + IKCLWINDCONHARMONICS_MAXOUTPUTS];
+        int nFields;
+        ikClwindconHarmonics harmonics;
+        double measuredPitch;
+        double measuredTorque;
+        ikClwindconSuperconState supercon;
+        int step;
+        FILE *log;
+        ikClwindconTelemetry telemetry;
+        ikClwindconFatigue fatigue;
+        char fatigueName[64];
+        ikClwindconStatistics statistics;
+        FILE *statisticsFile;
+#ifdef OPENDISCON_PROFILE_RANGES
+        ikClwindconRangeProfiler profiler;
+#endif
+        /* @endcond */
+    } ikClwindconTurbine;
+
+    /**
+     * Initialise an instance, at the first call
+     * @param self instance
+     * @param T communication interval in s, or 0 to use the configured sampling interval
+     * @param inFile controller parameter file name
+     * @param suffix suffix to the log file, fatigue report, statistics file and telemetry board names, e.g. to tell turbines apart
+     * @param turbine turbine index in the supercontroller channel, or -1 to use the configured one
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the controller could not be initialised
+     * @li -2: the log or statistics file could not be opened, or the suffix is too long
+     * @li -3: the telemetry board could not be created
+     * @li -4: the fatigue load monitor could not be initialised
+     * @li -5: the windowed statistics could not be initialised
+     * @li -6: the rotor harmonic monitors could not be initialised
+     * @li -7: the avrSWAP map in the controller parameter file is invalid, at least one of its lines has been skipped
+     */
+    int ikClwindconTurbine_init(ikClwindconTurbine *self, double T, const char *inFile, const char *suffix, int turbine);
+
+    /**
+     * Execute a call, i.e. read the inputs from the avrSWAP array, run the
+     * controller and write the outputs to the avrSWAP array, and write a statistics record
+     * at the end of each window and, at the last call, the fatigue load report
+     * @param self instance
+     * @param data avrSWAP array
+     */
+    void ikClwindconTurbine_step(ikClwindconTurbine *self, float *data);
+
+    /**
+     * Write the fatigue load report so far, to file fatigue<suffix>.txt
+     * @param self instance
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the file could not be opened
+     */
+    int ikClwindconTurbine_writeFatigue(const ikClwindconTurbine *self);
+
+    /**
+     * Get the number of avrSWAP array records used, which the avrSWAP array must have
+     * for @link ikClwindconTurbine_step @endlink
+     * @param self instance
+     * @return number of records
+     */
+    int ikClwindconTurbine_getSwapSize(const ikClwindconTurbine *self);
+
+    /**
+     * Check that all the avrSWAP records used come before the logging outputs, whose
+     * start is given in avrSWAP record 63. Those records are the only ones the simulator
+     * is bound to provide, the array size itself not being given.
+     * @param self instance
+     * @param data avrSWAP array
+     * @return error code:
+     * @li 0: no error, or the start of the logging outputs is not given
+     * @li -1: records at or beyond the start of the logging outputs are used
+     */
+    int ikClwindconTurbine_checkSwapSize(const ikClwindconTurbine *self, const float *data);
+
+    /**
+     * Close the log, the statistics file, the telemetry board and the supercontroller channel,
+     * and free what the controller has allocated
+     * @param self instance
+     */
+    void ikClwindconTurbine_close(ikClwindconTurbine *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKCLWINDCONTURBINE_H */
@@ -31,6 +31,11 @@ int ikClwindconWTCon_init(ikClwindconWTCon *self, const ikClwindconWTConParams *
     int err;
 	ikClwindconWTConParams params_ = *params;
 
+	/* nothing to free yet, should the initialisation stop early */
+	self->priv.powerManagerTuning = NULL;
+	self->priv.ownPowerManagerTuning = 0;
+	self->priv.powerManager.tuning = NULL;
+
 	/* pass reference to collective pitch demand for use in gain scheduling */
 	params_.collectivePitchControl.linearController.gainShedXVal = &(self->priv.collectivePitchDemand);
 
@@ -46,22 +51,64 @@ int ikClwindconWTCon_init(ikClwindconWTCon *self, const ikClwindconWTConParams *
     if (err) return -3;
     err = ikTpman_init(&(self->priv.tpManager), &(params_.torquePitchManager));
     if (err) return -5;
-	err = ikPowman_init(&(self->priv.powerManager), &(params_.powerManager));
-	if (err) return -6;
+	if (NULL == params->sharedPowerManagerTuning) {
+		/* allocate a tuning of our own, only if not sharing one */
+		self->priv.powerManagerTuning = (ikPowmanTuning *) malloc(sizeof(ikPowmanTuning));
+		if (NULL == self->priv.powerManagerTuning) return -6;
+		err = ikPowmanTuning_init(self->priv.powerManagerTuning, &(params_.powerManager));
+		if (err) {
+			free(self->priv.powerManagerTuning);
+			self->priv.powerManagerTuning = NULL;
+			return -6;
+		}
+		self->priv.ownPowerManagerTuning = 1;
+	} else {
+		self->priv.powerManagerTuning = params->sharedPowerManagerTuning;
+	}
+	ikPowman_init(&(self->priv.powerManager), self->priv.powerManagerTuning);
 	err = ikIpc_init(&(self->priv.ipc), &(params_.individualPitchControl));
 	if (err) return -7;
 	err = ikConLoop_init(&(self->priv.yawByIpc), &(params_.yawByIpc));
 	if (err) return -8;
 	err = ikSpdman_init(&(self->priv.speedSensorManager), &(params_.speedSensorManager));
 	if (err) return -9;
+	err = ikTrackingNotch_init(&(self->priv.speedNotch1P), &(params_.speedNotch1P));
+	if (err) return -10;
+	err = ikTrackingNotch_init(&(self->priv.speedNotch3P), &(params_.speedNotch3P));
+	if (err) return -11;
+	
+	/* register the yaw by ipc rate */
+	if (1 > params->yawByIpcDecimation) return -12;
+	if (0 > params->yawByIpcPhase || params->yawByIpcDecimation <= params->yawByIpcPhase) return -12;
+	self->priv.yawByIpcDecimation = params->yawByIpcDecimation;
+	self->priv.yawByIpcPhase = params->yawByIpcPhase;
+	self->priv.stepCount = 0;
+	self->priv.warmStarted = 0;
+	self->priv.yawErrorSum = 0.0;
+	self->priv.yawErrorReferenceSum = 0.0;
+	self->priv.yawByIpcSamples = 0;
     
     /* initialise feedback signals */
     self->priv.torqueFromTorqueCon = 0.0;
 	self->priv.collectivePitchDemand = 0.0;
+	
+	/* initialise held signals */
+	self->priv.individualPitchForYaw = 0.0;
 
     return 0;
 }
 
+void ikClwindconWTCon_close(ikClwindconWTCon *self) {
+	/* stop using the tuning, and free it if it is ours */
+	ikPowman_release(&(self->priv.powerManager));
+	if (self->priv.ownPowerManagerTuning) {
+		ikPowmanTuning_release(self->priv.powerManagerTuning);
+		free(self->priv.powerManagerTuning);
+	}
+	self->priv.powerManagerTuning = NULL;
+	self->priv.ownPowerManagerTuning = 0;
+}
+
 void ikClwindconWTCon_initParams(ikClwindconWTConParams *params) {
     /* pass on the member parameters */
     ikConLoop_initParams(&(params->collectivePitchControl));
@@ -72,15 +119,52 @@ void ikClwindconWTCon_initParams(ikClwindconWTConParams *params) {
 	ikIpc_initParams(&(params->individualPitchControl));
 	ikConLoop_initParams(&(params->yawByIpc));
 	ikSpdman_initParams(&(params->speedSensorManager));
+	ikTrackingNotch_initParams(&(params->speedNotch1P));
+	ikTrackingNotch_initParams(&(params->speedNotch3P));
+	
+	/* run everything every step */
+	params->yawByIpcDecimation = 1;
+	params->yawByIpcPhase = 0;
+	
+	/* use an own power manager tuning */
+	params->sharedPowerManagerTuning = NULL;
+}
+
+void ikClwindconWTCon_warmStart(ikClwindconWTCon *self, double pitch, double torque) {
+	
+	/* set the speed sensor manager up for the current speed and azimuth */
+	ikSpdman_warmStart(&(self->priv.speedSensorManager), self->in.rotorSpeed, self->in.azimuth);
+	
+	/* settle the rotor speed notches at the current speed */
+	ikTrackingNotch_warmStart(&(self->priv.speedNotch1P), self->in.generatorSpeed, self->in.generatorSpeed);
+	ikTrackingNotch_warmStart(&(self->priv.speedNotch3P), self->in.generatorSpeed, self->in.generatorSpeed);
+	
+	/* calculate the current minimum pitch, leaving the power manager for the first step */
+	self->priv.minPitchFromPowman = ikPowman_evalMinimumPitch(&(self->priv.powerManager), self->in.deratingRatio);
+	self->priv.minPitch = self->priv.minPitchFromPowman > self->in.externalMinimumPitch ? self->priv.minPitchFromPowman : self->in.externalMinimumPitch;
+	
+	/* start above rated if the blades are pitched */
+	ikTpman_warmStart(&(self->priv.tpManager), pitch, self->priv.minPitch);
+	
+	/* initialise feedback signals, which the control loops are held at for the first step */
+	self->priv.torqueFromTorqueCon = torque;
+	self->priv.collectivePitchDemand = pitch;
+	self->priv.warmStarted = 1;
 }
 
 int ikClwindconWTCon_step(ikClwindconWTCon *self) {
 	int i;
+	double lo;
+	double hi;
 	
 	/* run speed sensor manager */
 	ikSpdman_step(&(self->priv.speedSensorManager), self->in.generatorSpeed, self->in.rotorSpeed, self->in.azimuth);
 	ikSpdman_getOutput(&(self->priv.speedSensorManager), &(self->priv.generatorSpeedEquivalent), "generator speed equivalent");
 	
+	/* run rotor speed notches */
+	self->priv.notchedSpeed = ikTrackingNotch_step(&(self->priv.speedNotch1P), self->priv.generatorSpeedEquivalent, self->priv.generatorSpeedEquivalent);
+	self->priv.notchedSpeed = ikTrackingNotch_step(&(self->priv.speedNotch3P), self->priv.notchedSpeed, self->priv.generatorSpeedEquivalent);
+	
 	/* run power manager */
 	self->priv.maxTorqueFromPowman = ikPowman_step(&(self->priv.powerManager), self->in.deratingRatio, self->in.maximumSpeed, self->priv.generatorSpeedEquivalent);
 	ikPowman_getOutput(&(self->priv.powerManager), &(self->priv.minPitchFromPowman), "minimum pitch");
@@ -100,17 +184,41 @@ int ikClwindconWTCon_step(ikClwindconWTCon *self) {
     /* run drivetrain damper */
     self->priv.torqueFromDtdamper = ikConLoop_step(&(self->priv.dtdamper), 0.0, self->priv.generatorSpeedEquivalent, -(self->in.externalMaximumTorque), self->in.externalMaximumTorque);
 
-    /* run torque control */
-    self->priv.torqueFromTorqueCon = ikConLoop_step(&(self->priv.torquecon), self->in.maximumSpeed, self->priv.generatorSpeedEquivalent, self->priv.minTorque, self->priv.maxTorque);
+    /* run torque control, held at the torque fed back for the first step after a warm start */
+    lo = self->priv.minTorque;
+    hi = self->priv.maxTorque;
+    if (self->priv.warmStarted) {
+        lo = self->priv.torqueFromTorqueCon > lo ? self->priv.torqueFromTorqueCon : lo;
+        lo = lo < hi ? lo : hi;
+        hi = lo;
+    }
+    self->priv.torqueFromTorqueCon = ikConLoop_step(&(self->priv.torquecon), self->in.maximumSpeed, self->priv.notchedSpeed, lo, hi);
 
     /* calculate torque demand */
     self->out.torqueDemand = self->priv.torqueFromDtdamper + self->priv.torqueFromTorqueCon;
 
-    /* run collective pitch control */
-    self->priv.collectivePitchDemand = ikConLoop_step(&(self->priv.colpitchcon), self->in.maximumSpeed, self->priv.generatorSpeedEquivalent, self->priv.minPitch, self->priv.maxPitch);
+    /* run collective pitch control, held at the pitch fed back for the first step after a warm start */
+    lo = self->priv.minPitch;
+    hi = self->priv.maxPitch;
+    if (self->priv.warmStarted) {
+        lo = self->priv.collectivePitchDemand > lo ? self->priv.collectivePitchDemand : lo;
+        lo = lo < hi ? lo : hi;
+        hi = lo;
+    }
+    self->priv.collectivePitchDemand = ikConLoop_step(&(self->priv.colpitchcon), self->in.maximumSpeed, self->priv.notchedSpeed, lo, hi);
+    self->priv.warmStarted = 0;
 
-	/* run yaw by ipc */
-	self->priv.individualPitchForYaw = ikConLoop_step(&(self->priv.yawByIpc), self->in.yawErrorReference, self->in.yawError, -self->in.maximumIndividualPitch, self->in.maximumIndividualPitch);
+	/* run yaw by ipc, at its own rate, on its inputs averaged since it last ran against aliasing, holding its output in between */
+	self->priv.yawErrorSum += self->in.yawError;
+	self->priv.yawErrorReferenceSum += self->in.yawErrorReference;
+	self->priv.yawByIpcSamples++;
+	if (self->priv.yawByIpcPhase == self->priv.stepCount) {
+		self->priv.individualPitchForYaw = ikConLoop_step(&(self->priv.yawByIpc), self->priv.yawErrorReferenceSum/self->priv.yawByIpcSamples, self->priv.yawErrorSum/self->priv.yawByIpcSamples, -self->in.maximumIndividualPitch, self->in.maximumIndividualPitch);
+		self->priv.yawErrorSum = 0.0;
+		self->priv.yawErrorReferenceSum = 0.0;
+		self->priv.yawByIpcSamples = 0;
+	}
+	self->priv.stepCount = (self->priv.stepCount + 1) % self->priv.yawByIpcDecimation;
 
 	/* run individual pitch control */
 	self->priv.ipc.in.azimuth = self->in.azimuth;
@@ -131,6 +239,7 @@ int ikClwindconWTCon_step(ikClwindconWTCon *self) {
     self->out.pitchDemandBlade1 = self->priv.ipc.out.pitch[0];
     self->out.pitchDemandBlade2 = self->priv.ipc.out.pitch[1];
     self->out.pitchDemandBlade3 = self->priv.ipc.out.pitch[2];
+    self->out.collectivePitchDemand = self->priv.collectivePitchDemand;
 
     return self->priv.tpManState;
 }
@@ -184,6 +293,10 @@ int ikClwindconWTCon_getOutput(const ikClwindconWTCon *self, double *output, con
         *output = self->priv.generatorSpeedEquivalent;
         return 0;
     }
+    if (!strcmp(name, "notched generator speed")) {
+        *output = self->priv.notchedSpeed;
+        return 0;
+    }
 
     /* pick up the block names */
     sep = strstr(name, ">");
@@ -228,6 +341,16 @@ int ikClwindconWTCon_getOutput(const ikClwindconWTCon *self, double *output, con
         if (err) return -1;
         else return 0;
     }
+	if (!strncmp(name, "1P speed notch", strlen(name) - strlen(sep))) {
+        err = ikTrackingNotch_getOutput(&(self->priv.speedNotch1P), output, sep + 1);
+        if (err) return -1;
+        else return 0;
+    }
+	if (!strncmp(name, "3P speed notch", strlen(name) - strlen(sep))) {
+        err = ikTrackingNotch_getOutput(&(self->priv.speedNotch3P), output, sep + 1);
+        if (err) return -1;
+        else return 0;
+    }
 
 
     return -2;
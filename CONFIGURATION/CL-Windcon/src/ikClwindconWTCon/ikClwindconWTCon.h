@@ -35,6 +35,7 @@ extern "C" {
 #include "ikPowman.h"
 #include "ikIpc.h"
 #include "ikSpdman.h"
+#include "ikTrackingNotch.h"
 
     /**
      * @struct ikClwindconWTConInputs
@@ -65,11 +66,14 @@ extern "C" {
         double pitchDemandBlade1; /**<pitch demand for blade 1 in degrees*/
         double pitchDemandBlade2; /**<pitch demand for blade 2 in degrees*/
         double pitchDemandBlade3; /**<pitch demand for blade 3 in degrees*/
+        double collectivePitchDemand; /**<collective pitch demand in degrees*/
     } ikClwindconWTConOutputs;
 
     /* @cond */
 
     typedef struct ikClwindconWTConPrivate {
+		ikPowmanTuning *powerManagerTuning;
+		int ownPowerManagerTuning;
 		ikPowman powerManager;
         ikTpman   tpManager;
         ikConLoop dtdamper;
@@ -84,6 +88,7 @@ extern "C" {
         double torqueFromDtdamper;
         double torqueFromTorqueCon;
         double collectivePitchDemand;
+		int warmStarted;
 		double belowRatedTorque;
 		double minPitchFromPowman;
 		double maxTorqueFromPowman;
@@ -92,6 +97,15 @@ extern "C" {
 		double individualPitchForYaw;
 		ikSpdman speedSensorManager;
 		double generatorSpeedEquivalent;
+		ikTrackingNotch speedNotch1P;
+		ikTrackingNotch speedNotch3P;
+		double notchedSpeed;
+		int yawByIpcDecimation;
+		int yawByIpcPhase;
+		int stepCount;
+		double yawErrorSum;
+		double yawErrorReferenceSum;
+		int yawByIpcSamples;
     } ikClwindconWTConPrivate;
     /* @endcond */
 
@@ -101,6 +115,14 @@ extern "C" {
      * 
      * This is and ad hoc wind turbine controller for CL-Windcon.
      * 
+     * Yaw by IPC may run at a lower rate than the rest of the controller, i.e.
+     * once every @link ikClwindconWTConParams.yawByIpcDecimation @endlink steps,
+     * with its output held in between. Its parameters must then be tuned for the
+     * correspondingly longer sampling interval. Its inputs, the yaw error and its
+     * reference, are averaged at the full rate over the steps since it last ran,
+     * which notches out the frequencies that would otherwise alias onto the
+     * slower rate, at the cost of a delay of half the averaging window.
+     * 
      * @par Inputs
 	 * @li external maximum torque: externally set upper torque limit, in kNm, specify via @link ikClwindconWTConInputs.externalMaximumTorque @endlink at @link in @endlink
 	 * @li external minimum torque: externally set lower torque limit, in kNm, specify via @link ikClwindconWTConInputs.externalMinimumTorque @endlink at @link in @endlink
@@ -121,6 +143,7 @@ extern "C" {
      * @li pitch demand for blade 1: in degrees, get via @link ikClwindconWTConOutputs.pitchDemandBlade1 @endlink at @link out @endlink
      * @li pitch demand for blade 2: in degrees, get via @link ikClwindconWTConOutputs.pitchDemandBlade2 @endlink at @link out @endlink
      * @li pitch demand for blade 3: in degrees, get via @link ikClwindconWTConOutputs.pitchDemandBlade3 @endlink at @link out @endlink
+     * @li collective pitch demand: in degrees, get via @link ikClwindconWTConOutputs.collectivePitchDemand @endlink at @link out @endlink
      * 
      * @par Unit block
      * 
@@ -137,8 +160,10 @@ extern "C" {
      * @par Methods
      * @li @link ikClwindconWTCon_initParams @endlink initialise initialisation parameter structure
      * @li @link ikClwindconWTCon_init @endlink initialise an instance
+     * @li @link ikClwindconWTCon_warmStart @endlink set the initial state from the operating point
      * @li @link ikClwindconWTCon_step @endlink execute periodic calculations
      * @li @link ikClwindconWTCon_getOutput @endlink get output value
+     * @li @link ikClwindconWTCon_close @endlink free what the instance has allocated
      * 
      */
     typedef struct ikClwindconWTCon {
@@ -162,6 +187,11 @@ extern "C" {
 		ikIpcParams individualPitchControl; /**<individual pitch control parameters*/
 		ikConLoopParams yawByIpc; /**<yaw by ipc parameters*/
 		ikSpdmanParams speedSensorManager; /**<speed sensor manager parameters*/
+		ikTrackingNotchParams speedNotch1P; /**<1P rotor speed tracking notch parameters*/
+		ikTrackingNotchParams speedNotch3P; /**<3P rotor speed tracking notch parameters*/
+		int yawByIpcDecimation; /**<number of steps per yaw by ipc step, yaw by ipc runs every step if 1*/
+		int yawByIpcPhase; /**<step, between 0 and yawByIpcDecimation - 1, within each yawByIpcDecimation steps at which yaw by ipc runs*/
+		ikPowmanTuning *sharedPowerManagerTuning; /**<power manager tuning shared with other instances, which takes precedence over powerManager if not NULL, and must outlive them. Otherwise, each instance allocates a tuning of its own. The default value is NULL.*/
     } ikClwindconWTConParams;
 
     /**
@@ -174,19 +204,47 @@ extern "C" {
      * @li -2: torque control initialisation failed
      * @li -3: collective pitch control initialisation failed
      * @li -5: torque-pitch manager initialisation failed
-	 * @li -6: power manager initialisation failed
+	 * @li -6: power manager initialisation failed, or not enough memory for its tuning
 	 * @li -7: individual pitch control initialisation failed
 	 * @li -8: yaw by ipc initialisation failed
 	 * @li -9: speed sensor manager initialisation failed
+	 * @li -10: 1P speed notch initialisation failed
+	 * @li -11: 3P speed notch initialisation failed
+	 * @li -12: invalid yaw by ipc decimation or phase
      */
     int ikClwindconWTCon_init(ikClwindconWTCon *self, const ikClwindconWTConParams *params);
 
+    /**
+     * Free what the instance has allocated, i.e. its own power manager tuning, and stop
+     * using a shared one. To be called after @link ikClwindconWTCon_init @endlink,
+     * whether it succeeded or not, or on an instance cleared to zero.
+     * @param self controller instance
+     */
+    void ikClwindconWTCon_close(ikClwindconWTCon *self);
+
     /**
      * Initialise initialisation parameter structure
      * @param params initialisation parameter structure
      */
     void ikClwindconWTCon_initParams(ikClwindconWTConParams *params);
 
+    /**
+     * Set the initial state from the operating point, instead of starting from rest.
+     * To be called after @link ikClwindconWTCon_init @endlink, with the inputs
+     * at @link ikClwindconWTCon.in @endlink already set for the first step.
+     * The feedback signals (torque demand and collective pitch demand), the
+     * torque-pitch manager state, the speed sensor manager and the rotor speed notches
+     * are set to their steady state. Torque control and collective pitch control then
+     * have their output limits pinned to the given torque and pitch, within their
+     * usual limits, for the first step, so that their integrators are saturated there
+     * and carry on from the operating point. The drivetrain damper and individual pitch
+     * control start from rest.
+     * @param self controller instance
+     * @param pitch current collective pitch angle, in degrees
+     * @param torque current generator torque, in kNm
+     */
+    void ikClwindconWTCon_warmStart(ikClwindconWTCon *self, double pitch, double torque);
+
     /**
      * Execute periodic calculations
      * @param self controller instance
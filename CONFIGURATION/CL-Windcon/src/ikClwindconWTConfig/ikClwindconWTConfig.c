@@ -23,9 +23,14 @@ along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
  * @brief CL-Windcon wind turbine controller configuration implementation
  */
 
+#include <math.h>
 #include "ikClwindconWTConfig.h"
 
 void setParams(ikClwindconWTConParams *param) {
+	setParamsForInterval(param, getSamplingInterval());
+}
+
+double getSamplingInterval(void) {
 	/*! [Sampling interval] */
     /*
 	####################################################################
@@ -39,6 +44,49 @@ void setParams(ikClwindconWTConParams *param) {
 	*/
 	/*! [Sampling interval] */
 
+	return T;
+}
+
+int getWarmStart(void) {
+	/*! [Warm start] */
+    /*
+	####################################################################
+                     Warm start
+
+    Set whether to start from the simulator's operating point (1), or
+    from rest (0), here:
+	*/
+	const int warmStart = 0; /* [-] */
+    /*
+    ####################################################################
+	*/
+	/*! [Warm start] */
+
+	return warmStart;
+}
+
+double getGearboxRatio(void) {
+	/*! [Gearbox ratio] */
+    /*
+	####################################################################
+                     Gearbox ratio
+
+    Ratio of the generator speed to the rotor speed, used wherever one
+    is derived from the other.
+
+    Set gearbox ratio here:
+	*/
+	const double gbRatio = 50.0; /* [-] */
+    /*
+    ####################################################################
+	*/
+	/*! [Gearbox ratio] */
+
+	return gbRatio;
+}
+
+void setParamsForInterval(ikClwindconWTConParams *param, double T) {
+
 	ikTuneDrivetrainDamper(&(param->drivetrainDamper), T);
 	ikTuneSpeedRange(&(param->torqueControl));
 	ikTunePowerSettings(&(param->powerManager));
@@ -54,9 +102,11 @@ void setParams(ikClwindconWTConParams *param) {
 	ikConfigureRotorForIpc(&(param->individualPitchControl));
 	ikTuneIpcMyPI(&(param->individualPitchControl.controlMy), T);
 	ikTuneIpcMzPI(&(param->individualPitchControl.controlMz), T);
-	ikTuneYawByIpc(&(param->yawByIpc), T);
-	ikTuneYawByIpcLowpassFilter(&(param->yawByIpc), T);
+	ikConfigureYawByIpcRate(param);
+	ikTuneYawByIpc(&(param->yawByIpc), T*param->yawByIpcDecimation);
+	ikTuneYawByIpcLowpassFilter(&(param->yawByIpc), T*param->yawByIpcDecimation);
 	ikConfigureSpeedManager(&(param->speedSensorManager), T);
+	ikTuneSpeedNotches(&(param->speedNotch1P), &(param->speedNotch3P), T);
 
 }
 
@@ -84,22 +134,7 @@ void ikTuneDrivetrainDamper(ikConLoopParams *params, double T) {
 	/*! [Drivetrain damper] */
 
 
-    /*
-	tune the drivetrain damper to this tf:
-                       z^2 - 1
-    D(z) = G*T/2*w^2 -------------------------------------------------------------------------------
-                     (1 + T*d*w + T^2*w^2/4)*z^2 -2*(1 - T^2*w^2/4)*z + (1 - T*d*w + T^2*w^2/4)
-    rad/s --> kNm
-	*/
-    params->linearController.errorTfs.tfParams[0].enable = 1;
-    params->linearController.errorTfs.tfParams[0].b[0] = 1.0;
-    params->linearController.errorTfs.tfParams[0].b[1] = 0.0;
-    params->linearController.errorTfs.tfParams[0].b[2] = -1.0;
-    params->linearController.errorTfs.tfParams[0].a[0] = 1.0 + T*d*w + T*T*w*w/4.0;
-    params->linearController.errorTfs.tfParams[0].a[1] = -2.0*(1.0 - T*T*w*w/4.0);
-    params->linearController.errorTfs.tfParams[0].a[2] = (1.0 - T*d*w + T*T*w*w/4.0);
-    params->linearController.errorTfs.tfParams[1].enable = 1;
-    params->linearController.errorTfs.tfParams[1].b[0] = -G*T/2.0*w*w;
+	ikTuneDamper(params, G, d, w, T);
 
 }
 
@@ -206,8 +241,7 @@ This is an original implementation of derating strategy 3a as described by ECN i
 }
 
 void ikTunePitchPIGainSchedule(ikConLoopParams *params) {
-	int i;
-	
+
 	/*! [Gain schedule] */
     /*
 	####################################################################
@@ -223,12 +257,8 @@ void ikTunePitchPIGainSchedule(ikConLoopParams *params) {
 	*/
 	/*! [Gain schedule] */
 
-	params->linearController.gainSchedN = n;
+	ikTuneGainSchedule(params, n, pitch, gain);
 
-	for (i = 0; i < n; i++) {
-		params->linearController.gainSchedX[i] = pitch[i];
-		params->linearController.gainSchedY[i] = gain[i];
-	}	
 }
 
 void ikTunePitchLowpassFilter(ikConLoopParams *params, double T) {
@@ -252,30 +282,7 @@ void ikTunePitchLowpassFilter(ikConLoopParams *params, double T) {
 	*/
 	/*! [Pitch lowpass filter] */
 
-    /*
-	tune the pitch control feedback filter to this tf (twice, mind you):
-                   (0.5*T*w)^2                                                                     z^2 + 2z + 1
-    H(z) =  -----------------------------   ------------------------------------------------------------------------------------------------------------------------
-            1 + T*d*w +  (0.5*T*w)^2    z^2 - 2*(1 - (0.5*T*w)^2) / (1 + T*d*w +  (0.5*T*w)^2)z +  (1 - T*d*w +  (0.5*T*w)^2) / (1 + T*d*w +  (0.5*T*w)^2)
-    */
-	params->linearController.measurementTfs.tfParams[1].enable = 1;
-    params->linearController.measurementTfs.tfParams[1].b[0] = 1.0;
-    params->linearController.measurementTfs.tfParams[1].b[1] = 2.0;
-    params->linearController.measurementTfs.tfParams[1].b[2] = 1.0;
-    params->linearController.measurementTfs.tfParams[1].a[0] = 1.0;
-    params->linearController.measurementTfs.tfParams[1].a[1] = -2 * (1 - (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
-    params->linearController.measurementTfs.tfParams[1].a[2] = (1 - T*d*w + (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
-
-    params->linearController.measurementTfs.tfParams[2].enable = 1;
-    params->linearController.measurementTfs.tfParams[2].b[0] = 1.0;
-    params->linearController.measurementTfs.tfParams[2].b[1] = 2.0;
-    params->linearController.measurementTfs.tfParams[2].b[2] = 1.0;
-    params->linearController.measurementTfs.tfParams[2].a[0] = 1.0;
-    params->linearController.measurementTfs.tfParams[2].a[1] = -2 * (1 - (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
-    params->linearController.measurementTfs.tfParams[2].a[2] = (1 - T*d*w + (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
-
-    params->linearController.measurementTfs.tfParams[3].enable = 1;
-    params->linearController.measurementTfs.tfParams[3].b[0] = ((0.5*T*w)*(0.5*T*w) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w))) * ((0.5*T*w)*(0.5*T*w) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w)));
+	ikTuneLowpass(params, 0, 2, w, d, T);
 
 }
 
@@ -301,11 +308,7 @@ void ikTunePitchNotches(ikConLoopParams *params, double T) {
 	*/
 	/*! [1st fore-aft tower mode filter] */
 
-    params->linearController.measurementNotches.dT = T;
-    params->linearController.measurementNotches.notchParams[0].enable = 1;
-    params->linearController.measurementNotches.notchParams[0].freq = w;
-    params->linearController.measurementNotches.notchParams[0].dampNum = dnum;
-    params->linearController.measurementNotches.notchParams[0].dampDen = dden;
+	ikTuneNotch(params, 0, w, dnum, dden, T);
 
 }
 
@@ -332,28 +335,7 @@ void ikTunePitchPI(ikConLoopParams *params, double T) {
 	/*! [Pitch PI] */
 
 
-	/*
-	tune the speed control to this tf:
-           (Kp + Ki*T/2)z - (Kp - Ki*T/2)
-    C(z) = ------------------------------
-                      z - 1
-	rad/s --> deg
-	*/
-	params->linearController.errorTfs.tfParams[0].enable = 1;
-    params->linearController.errorTfs.tfParams[0].b[0] = (Kp + Ki*T/2);
-    params->linearController.errorTfs.tfParams[0].b[1] = -(Kp - Ki*T/2);
-    params->linearController.errorTfs.tfParams[0].b[2] = 0.0;
-    params->linearController.errorTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.errorTfs.tfParams[0].a[1] = 0.0;
-    params->linearController.errorTfs.tfParams[0].a[2] = 0.0;
-
-	params->linearController.postGainTfs.tfParams[0].enable = 1;
-    params->linearController.postGainTfs.tfParams[0].b[0] = 1.0;
-    params->linearController.postGainTfs.tfParams[0].b[1] = 0.0;
-    params->linearController.postGainTfs.tfParams[0].b[2] = 0.0;
-    params->linearController.postGainTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.postGainTfs.tfParams[0].a[1] = -1.0;
-    params->linearController.postGainTfs.tfParams[0].a[2] = 0.0;
+	ikTunePI(params, Kp, Ki, T);
 
 }
 
@@ -378,30 +360,7 @@ void ikTuneTorqueLowpassFilter(ikConLoopParams *params, double T) {
 	*/
 	/*! [Torque lowpass filter] */
 
-    /*
-	tune the torque control feedback filter to this tf (twice, mind you):
-                   (0.5*T*w)^2                                                                     z^2 + 2z + 1
-    H(z) =  -----------------------------   ------------------------------------------------------------------------------------------------------------------------
-            1 + T*d*w +  (0.5*T*w)^2    z^2 - 2*(1 - (0.5*T*w)^2) / (1 + T*d*w +  (0.5*T*w)^2)z +  (1 - T*d*w +  (0.5*T*w)^2) / (1 + T*d*w +  (0.5*T*w)^2)
-	*/
-    params->linearController.measurementTfs.tfParams[0].enable = 1;
-    params->linearController.measurementTfs.tfParams[0].b[0] = 1.0;
-    params->linearController.measurementTfs.tfParams[0].b[1] = 2.0;
-    params->linearController.measurementTfs.tfParams[0].b[2] = 1.0;
-    params->linearController.measurementTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.measurementTfs.tfParams[0].a[1] = -2 * (1 - (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
-    params->linearController.measurementTfs.tfParams[0].a[2] = (1 - T*d*w + (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
-
-    params->linearController.measurementTfs.tfParams[1].enable = 1;
-    params->linearController.measurementTfs.tfParams[1].b[0] = 1.0;
-    params->linearController.measurementTfs.tfParams[1].b[1] = 2.0;
-    params->linearController.measurementTfs.tfParams[1].b[2] = 1.0;
-    params->linearController.measurementTfs.tfParams[1].a[0] = 1.0;
-    params->linearController.measurementTfs.tfParams[1].a[1] = -2 * (1 - (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
-    params->linearController.measurementTfs.tfParams[1].a[2] = (1 - T*d*w + (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
-
-    params->linearController.measurementTfs.tfParams[2].enable = 1;
-    params->linearController.measurementTfs.tfParams[2].b[0] = ((0.5*T*w)*(0.5*T*w) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w))) * ((0.5*T*w)*(0.5*T*w) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w)));
+	ikTuneLowpass(params, 0, 2, w, d, T);
 
 }
 
@@ -427,11 +386,7 @@ void ikTuneTorqueNotches(ikConLoopParams *params, double T) {
 	*/
 	/*! [1st side-side tower mode filter] */
 
-    params->linearController.measurementNotches.dT = T;
-    params->linearController.measurementNotches.notchParams[0].enable = 1;
-    params->linearController.measurementNotches.notchParams[0].freq = w;
-    params->linearController.measurementNotches.notchParams[0].dampNum = dnum;
-    params->linearController.measurementNotches.notchParams[0].dampDen = dden;
+	ikTuneNotch(params, 0, w, dnum, dden, T);
 
 }
 
@@ -457,28 +412,7 @@ void ikTuneTorquePI(ikConLoopParams *params, double T) {
 	*/
 	/*! [Torque PI] */
 
-	/*
-	tune the torque control to this tf:
-           (Kp + Ki*T/2)z - (Kp - Ki*T/2)
-    C(z) = ------------------------------
-                      z - 1
-	rad/s --> kNm
-	*/
-	params->linearController.errorTfs.tfParams[0].enable = 1;
-    params->linearController.errorTfs.tfParams[0].b[0] = (Kp + Ki*T/2);
-    params->linearController.errorTfs.tfParams[0].b[1] = -(Kp - Ki*T/2);
-    params->linearController.errorTfs.tfParams[0].b[2] = 0.0;
-    params->linearController.errorTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.errorTfs.tfParams[0].a[1] = 0.0;
-    params->linearController.errorTfs.tfParams[0].a[2] = 0.0;
-
-	params->linearController.postGainTfs.tfParams[0].enable = 1;
-    params->linearController.postGainTfs.tfParams[0].b[0] = 1.0;
-    params->linearController.postGainTfs.tfParams[0].b[1] = 0.0;
-    params->linearController.postGainTfs.tfParams[0].b[2] = 0.0;
-    params->linearController.postGainTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.postGainTfs.tfParams[0].a[1] = -1.0;
-    params->linearController.postGainTfs.tfParams[0].a[2] = 0.0;
+	ikTunePI(params, Kp, Ki, T);
 
 }
 
@@ -511,28 +445,7 @@ void ikTuneIpcMyPI(ikConLoopParams *params, double T) {
 	*/
 	/*! [IPC My PI] */
 
-	/*
-	tune the ipc My control to this tf:
-           (Kp + Ki*T/2)z - (Kp - Ki*T/2)
-    C(z) = ------------------------------
-                      z - 1
-	rad/s --> kNm
-	*/
-	params->linearController.errorTfs.tfParams[0].enable = 1;
-    params->linearController.errorTfs.tfParams[0].b[0] = (Kp + Ki*T/2);
-    params->linearController.errorTfs.tfParams[0].b[1] = -(Kp - Ki*T/2);
-    params->linearController.errorTfs.tfParams[0].b[2] = 0.0;
-    params->linearController.errorTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.errorTfs.tfParams[0].a[1] = 0.0;
-    params->linearController.errorTfs.tfParams[0].a[2] = 0.0;
-
-	params->linearController.postGainTfs.tfParams[0].enable = 1;
-    params->linearController.postGainTfs.tfParams[0].b[0] = 1.0;
-    params->linearController.postGainTfs.tfParams[0].b[1] = 0.0;
-    params->linearController.postGainTfs.tfParams[0].b[2] = 0.0;
-    params->linearController.postGainTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.postGainTfs.tfParams[0].a[1] = -1.0;
-    params->linearController.postGainTfs.tfParams[0].a[2] = 0.0;
+	ikTunePI(params, Kp, Ki, T);
 
 }
 
@@ -558,28 +471,33 @@ void ikTuneIpcMzPI(ikConLoopParams *params, double T) {
 	*/
 	/*! [IPC Mz PI] */
 
-	/*
-	tune the ipc Mz control to this tf:
-           (Kp + Ki*T/2)z - (Kp - Ki*T/2)
-    C(z) = ------------------------------
-                      z - 1
-	rad/s --> kNm
+	ikTunePI(params, Kp, Ki, T);
+
+}
+
+void ikConfigureYawByIpcRate(ikClwindconWTConParams *params) {
+
+	/*! [Yaw by IPC rate] */
+    /*
+	####################################################################
+                    Yaw by IPC rate
+
+    Yaw by IPC runs once every N sampling intervals, at step n out of
+    every N, and its output is held in between. Its inputs are averaged
+    over the N sampling intervals since it last ran, against aliasing.
+    Its PI and low pass filter are tuned for a sampling interval of N*T.
+
+    Set parameters here:
 	*/
-	params->linearController.errorTfs.tfParams[0].enable = 1;
-    params->linearController.errorTfs.tfParams[0].b[0] = (Kp + Ki*T/2);
-    params->linearController.errorTfs.tfParams[0].b[1] = -(Kp - Ki*T/2);
-    params->linearController.errorTfs.tfParams[0].b[2] = 0.0;
-    params->linearController.errorTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.errorTfs.tfParams[0].a[1] = 0.0;
-    params->linearController.errorTfs.tfParams[0].a[2] = 0.0;
+    const int N = 10; /* [-] */
+    const int n = 0; /* [-] */
+    /*
+    ####################################################################
+	*/
+	/*! [Yaw by IPC rate] */
 
-	params->linearController.postGainTfs.tfParams[0].enable = 1;
-    params->linearController.postGainTfs.tfParams[0].b[0] = 1.0;
-    params->linearController.postGainTfs.tfParams[0].b[1] = 0.0;
-    params->linearController.postGainTfs.tfParams[0].b[2] = 0.0;
-    params->linearController.postGainTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.postGainTfs.tfParams[0].a[1] = -1.0;
-    params->linearController.postGainTfs.tfParams[0].a[2] = 0.0;
+	params->yawByIpcDecimation = N;
+	params->yawByIpcPhase = n;
 
 }
 
@@ -608,28 +526,7 @@ This is an original implementation of the yaw by IPC strategy in 87e4a2fe8e8ac8f
 	*/
 	/*! [Yaw by IPC PI] */
 
-	/*
-	tune the yaw by ipc control to this tf:
-           (Kp + Ki*T/2)z - (Kp - Ki*T/2)
-    C(z) = ------------------------------
-                      z - 1
-	deg --> deg
-	*/
-	params->linearController.errorTfs.tfParams[0].enable = 1;
-    params->linearController.errorTfs.tfParams[0].b[0] = (Kp + Ki*T/2);
-    params->linearController.errorTfs.tfParams[0].b[1] = -(Kp - Ki*T/2);
-    params->linearController.errorTfs.tfParams[0].b[2] = 0.0;
-    params->linearController.errorTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.errorTfs.tfParams[0].a[1] = 0.0;
-    params->linearController.errorTfs.tfParams[0].a[2] = 0.0;
-
-	params->linearController.postGainTfs.tfParams[0].enable = 1;
-    params->linearController.postGainTfs.tfParams[0].b[0] = 1.0;
-    params->linearController.postGainTfs.tfParams[0].b[1] = 0.0;
-    params->linearController.postGainTfs.tfParams[0].b[2] = 0.0;
-    params->linearController.postGainTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.postGainTfs.tfParams[0].a[1] = -1.0;
-    params->linearController.postGainTfs.tfParams[0].a[2] = 0.0;
+	ikTunePI(params, Kp, Ki, T);
 
 }
 
@@ -658,22 +555,7 @@ This is an original implementation of the yaw by IPC strategy in 87e4a2fe8e8ac8f
 	*/
 	/*! [Yaw by IPC lowpass filter] */
 
-    /*
-	tune the yaw by ipc control feedback filter to this tf:
-                   (0.5*T*w)^2                                                                     z^2 + 2z + 1
-    H(z) =  -----------------------------   ------------------------------------------------------------------------------------------------------------------------
-            1 + T*d*w +  (0.5*T*w)^2    z^2 - 2*(1 - (0.5*T*w)^2) / (1 + T*d*w +  (0.5*T*w)^2)z +  (1 - T*d*w +  (0.5*T*w)^2) / (1 + T*d*w +  (0.5*T*w)^2)
-	*/
-    params->linearController.measurementTfs.tfParams[0].enable = 1;
-    params->linearController.measurementTfs.tfParams[0].b[0] = 1.0;
-    params->linearController.measurementTfs.tfParams[0].b[1] = 2.0;
-    params->linearController.measurementTfs.tfParams[0].b[2] = 1.0;
-    params->linearController.measurementTfs.tfParams[0].a[0] = 1.0;
-    params->linearController.measurementTfs.tfParams[0].a[1] = -2 * (1 - (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
-    params->linearController.measurementTfs.tfParams[0].a[2] = (1 - T*d*w + (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
-
-    params->linearController.measurementTfs.tfParams[1].enable = 1;
-    params->linearController.measurementTfs.tfParams[1].b[0] = (0.5*T*w)*(0.5*T*w) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
+	ikTuneLowpass(params, 0, 1, w, d, T);
 
 }
 
@@ -692,7 +574,6 @@ void ikConfigureSpeedManager(ikSpdmanParams *params, double T) {
 	*/
 	const int N = 10; /* [-] */
 	const double tol = 1.0; /* [rad/s] */
-	const double gbRatio = 50.0; /* [-] */
     /*
     ####################################################################
 	*/
@@ -701,9 +582,166 @@ void ikConfigureSpeedManager(ikSpdmanParams *params, double T) {
 	params->diagnoser.nStepsToFault = N;
 	params->diagnoser.tolerance = tol;
 	
-	params->gearboxRatio = gbRatio;
+	params->gearboxRatio = getGearboxRatio();
 	params->T = T;
 	params->minAzimuth = 0.0;
 	params->maxAzimuth = 360.0;
 	
 }
+
+void ikTuneSpeedNotches(ikTrackingNotchParams *notch1P, ikTrackingNotchParams *notch3P, double T) {
+
+	/*! [Rotor speed notches] */
+    /*
+	####################################################################
+                    Rotor speed tracking notch filters
+
+    Transfer function:
+    H(s) = (s^2 + 2*dnum*w*s + w^2) / (s^2 + 2*dden*w*s + w^2)
+
+    with w = n*W, W being the rotor speed, i.e. the generator speed
+    divided by the gearbox ratio, and n the harmonic (1P, 3P).
+    The coefficients are recalculated whenever w moves by more than tol
+    (relative) from the last calculation.
+
+    The sampling time is given by function parameter T.
+
+    Set parameters here:
+	*/
+    const int enable1P = 0; /* [-] */
+    const double dnum1P = 0.01; /* [-] */
+    const double dden1P = 0.2; /* [-] */
+    const int enable3P = 0; /* [-] */
+    const double dnum3P = 0.01; /* [-] */
+    const double dden3P = 0.2; /* [-] */
+    const double tol = 0.01; /* [-] */
+    /*
+    ####################################################################
+	*/
+	/*! [Rotor speed notches] */
+
+	/* keep the centre frequencies below the Nyquist frequency */
+	notch1P->maxFreq = 0.9*3.14159265358979/T < notch1P->maxFreq ? 0.9*3.14159265358979/T : notch1P->maxFreq;
+	notch3P->maxFreq = 0.9*3.14159265358979/T < notch3P->maxFreq ? 0.9*3.14159265358979/T : notch3P->maxFreq;
+
+	notch1P->enable = enable1P;
+	notch1P->T = T;
+	notch1P->harmonic = 1.0;
+	notch1P->gearboxRatio = getGearboxRatio();
+	notch1P->dampNum = dnum1P;
+	notch1P->dampDen = dden1P;
+	notch1P->tolerance = tol;
+
+	notch3P->enable = enable3P;
+	notch3P->T = T;
+	notch3P->harmonic = 3.0;
+	notch3P->gearboxRatio = getGearboxRatio();
+	notch3P->dampNum = dnum3P;
+	notch3P->dampDen = dden3P;
+	notch3P->tolerance = tol;
+
+}
+
+void ikTunePI(ikConLoopParams *params, double Kp, double Ki, double T) {
+
+	/*
+	tune the control to this tf:
+           (Kp + Ki*T/2)z - (Kp - Ki*T/2)
+    C(z) = ------------------------------
+                      z - 1
+	*/
+	params->linearController.errorTfs.tfParams[0].enable = 1;
+    params->linearController.errorTfs.tfParams[0].b[0] = (Kp + Ki*T/2);
+    params->linearController.errorTfs.tfParams[0].b[1] = -(Kp - Ki*T/2);
+    params->linearController.errorTfs.tfParams[0].b[2] = 0.0;
+    params->linearController.errorTfs.tfParams[0].a[0] = 1.0;
+    params->linearController.errorTfs.tfParams[0].a[1] = 0.0;
+    params->linearController.errorTfs.tfParams[0].a[2] = 0.0;
+
+	params->linearController.postGainTfs.tfParams[0].enable = 1;
+    params->linearController.postGainTfs.tfParams[0].b[0] = 1.0;
+    params->linearController.postGainTfs.tfParams[0].b[1] = 0.0;
+    params->linearController.postGainTfs.tfParams[0].b[2] = 0.0;
+    params->linearController.postGainTfs.tfParams[0].a[0] = 1.0;
+    params->linearController.postGainTfs.tfParams[0].a[1] = -1.0;
+    params->linearController.postGainTfs.tfParams[0].a[2] = 0.0;
+
+}
+
+void ikTuneLowpass(ikConLoopParams *params, int first, int n, double w, double d, double T) {
+	int i;
+	double gain;
+
+	/* prewarp, so that the discrete filter has its corner at w for any T */
+	w = 2.0/T*tan(w*T/2.0);
+
+    /*
+	tune the feedback filter to this tf (n times):
+                   (0.5*T*w)^2                                                                     z^2 + 2z + 1
+    H(z) =  -----------------------------   ------------------------------------------------------------------------------------------------------------------------
+            1 + T*d*w +  (0.5*T*w)^2    z^2 - 2*(1 - (0.5*T*w)^2) / (1 + T*d*w +  (0.5*T*w)^2)z +  (1 - T*d*w +  (0.5*T*w)^2) / (1 + T*d*w +  (0.5*T*w)^2)
+
+	the gain is folded into the numerator of each section, rather than
+	given a transfer function of its own, so there is one section less to
+	run every step and each section has unity static gain
+	*/
+	gain = (0.5*T*w)*(0.5*T*w) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
+	for (i = first; i < first + n; i++) {
+		params->linearController.measurementTfs.tfParams[i].enable = 1;
+		params->linearController.measurementTfs.tfParams[i].b[0] = gain;
+		params->linearController.measurementTfs.tfParams[i].b[1] = 2.0*gain;
+		params->linearController.measurementTfs.tfParams[i].b[2] = gain;
+		params->linearController.measurementTfs.tfParams[i].a[0] = 1.0;
+		params->linearController.measurementTfs.tfParams[i].a[1] = -2 * (1 - (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
+		params->linearController.measurementTfs.tfParams[i].a[2] = (1 - T*d*w + (0.5*T*w)*(0.5*T*w)) / (1 + T*d*w + (0.5*T*w)*(0.5*T*w));
+	}
+
+}
+
+void ikTuneNotch(ikConLoopParams *params, int i, double w, double dnum, double dden, double T) {
+
+    params->linearController.measurementNotches.dT = T;
+    params->linearController.measurementNotches.notchParams[i].enable = 1;
+    params->linearController.measurementNotches.notchParams[i].freq = w;
+    params->linearController.measurementNotches.notchParams[i].dampNum = dnum;
+    params->linearController.measurementNotches.notchParams[i].dampDen = dden;
+
+}
+
+void ikTuneDamper(ikConLoopParams *params, double G, double d, double w, double T) {
+	double K;
+
+	/* prewarped bilinear transform constant, so that the discrete damper has
+	   its peak at w for any T, with the same peak gain G*w/(2*d) as D(s) */
+	K = w/tan(w*T/2.0);
+
+    /*
+	tune the drivetrain damper to this tf:
+                       z^2 - 1
+    D(z) = G*w^2/K -------------------------------------------------------------------------------
+                   (1 + 2*d*w/K + (w/K)^2)*z^2 -2*(1 - (w/K)^2)*z + (1 - 2*d*w/K + (w/K)^2)
+    rad/s --> kNm
+
+	which is the plain bilinear transform for K = 2/T. The gain is folded
+	into the numerator, rather than given a transfer function of its own
+	*/
+    params->linearController.errorTfs.tfParams[0].enable = 1;
+    params->linearController.errorTfs.tfParams[0].b[0] = -G*w*w/K;
+    params->linearController.errorTfs.tfParams[0].b[1] = 0.0;
+    params->linearController.errorTfs.tfParams[0].b[2] = G*w*w/K;
+    params->linearController.errorTfs.tfParams[0].a[0] = 1.0 + 2.0*d*w/K + (w/K)*(w/K);
+    params->linearController.errorTfs.tfParams[0].a[1] = -2.0*(1.0 - (w/K)*(w/K));
+    params->linearController.errorTfs.tfParams[0].a[2] = (1.0 - 2.0*d*w/K + (w/K)*(w/K));
+
+}
+
+void ikTuneGainSchedule(ikConLoopParams *params, int n, const double *x, const double *y) {
+	int i;
+
+	params->linearController.gainSchedN = n;
+
+	for (i = 0; i < n; i++) {
+		params->linearController.gainSchedX[i] = x[i];
+		params->linearController.gainSchedY[i] = y[i];
+	}	
+}
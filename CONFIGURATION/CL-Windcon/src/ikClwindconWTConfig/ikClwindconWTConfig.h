@@ -33,6 +33,14 @@ extern "C" {
 #include "ikClwindconWTCon.h"  
 
 	void setParams(ikClwindconWTConParams *param);
+
+	void setParamsForInterval(ikClwindconWTConParams *param, double T);
+
+	double getSamplingInterval(void);
+	
+	int getWarmStart(void);
+	
+	double getGearboxRatio(void);
 	
 	void ikTuneDrivetrainDamper(ikConLoopParams *params, double T);
 	
@@ -64,12 +72,28 @@ extern "C" {
 
 	void ikTuneIpcMzPI(ikConLoopParams *params, double T);
 
+	void ikConfigureYawByIpcRate(ikClwindconWTConParams *params);
+
 	void ikTuneYawByIpc(ikConLoopParams *params, double T);
 
 	void ikTuneYawByIpcLowpassFilter(ikConLoopParams *params, double T);
 
 	void ikConfigureSpeedManager(ikSpdmanParams *params, double T);
 
+	void ikTuneSpeedNotches(ikTrackingNotchParams *notch1P, ikTrackingNotchParams *notch3P, double T);
+
+	/* tuning in terms of continuous-domain parameters, e.g. for automatic tuning tools */
+
+	void ikTunePI(ikConLoopParams *params, double Kp, double Ki, double T);
+
+	void ikTuneLowpass(ikConLoopParams *params, int first, int n, double w, double d, double T);
+
+	void ikTuneNotch(ikConLoopParams *params, int i, double w, double dnum, double dden, double T);
+
+	void ikTuneDamper(ikConLoopParams *params, double G, double d, double w, double T);
+
+	void ikTuneGainSchedule(ikConLoopParams *params, int n, const double *x, const double *y);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,157 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file ikDenormalBench.c
+ *
+ * @brief Denormal benchmark
+ *
+ * Times a lightly damped second-order filter, in transposed direct form II as the
+ * controller filters are, while its state decays with no input. Each run starts
+ * either from a normal state, which stays normal, or from the smallest normal
+ * state, which decays through the denormal (subnormal) range, and the latter is
+ * run with and without flushing denormals to zero, as @link discon.c @endlink
+ * does while the controller runs. It reports the time per step and the fraction
+ * of steps whose output was denormal. Usage:
+ * @code
+ * ikDenormalBench [nSteps [nRuns]]
+ * @endcode
+ * with 50000 steps and 20 runs by default.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include <time.h>
+
+/* flush denormals to zero, the same way as discon.c, where SSE is available */
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FTZ_DAZ_BITS 0x8040u /* flush to zero (bit 15) and denormals are zero (bit 6) */
+#define ENTER_FTZ_DAZ(csr) do { (csr) = _mm_getcsr(); _mm_setcsr((csr) | FTZ_DAZ_BITS); } while (0)
+#define LEAVE_FTZ_DAZ(csr) _mm_setcsr(csr)
+#define HAVE_FTZ_DAZ 1
+#else
+#define ENTER_FTZ_DAZ(csr) ((void) (csr))
+#define LEAVE_FTZ_DAZ(csr) ((void) (csr))
+#define HAVE_FTZ_DAZ 0
+#endif
+
+typedef struct biquad {
+	double b[3];
+	double a[3];
+	double state[2];
+} biquad;
+
+/* resonance at w rad/s with damping factor d, sampled every T s, unit static gain */
+static void biquad_init(biquad *self, double w, double d, double T) {
+	double r = exp(-d*w*T);
+	double theta = w*T*sqrt(1.0 - d*d);
+	
+	self->a[0] = 1.0;
+	self->a[1] = -2.0*r*cos(theta);
+	self->a[2] = r*r;
+	self->b[0] = self->a[0] + self->a[1] + self->a[2];
+	self->b[1] = 0.0;
+	self->b[2] = 0.0;
+	self->state[0] = 0.0;
+	self->state[1] = 0.0;
+}
+
+static double biquad_step(biquad *self, double input) {
+	double output = self->b[0]*input + self->state[0];
+	
+	self->state[0] = self->b[1]*input - self->a[1]*output + self->state[1];
+	self->state[1] = self->b[2]*input - self->a[2]*output;
+	
+	return output;
+}
+
+/* decay from the given state for nSteps, nRuns times, and return the time per step in ns */
+static double run(biquad *filter, double start, int nSteps, int nRuns, int flush, double *denormal) {
+	unsigned int csr = 0;
+	double sum = 0.0;
+	long count = 0;
+	clock_t t;
+	double y;
+	int i;
+	int j;
+	
+	if (flush) ENTER_FTZ_DAZ(csr);
+	
+	/* count the denormal outputs, untimed */
+	filter->state[0] = start;
+	filter->state[1] = 0.0;
+	for (i = 0; i < nSteps; i++) {
+		y = biquad_step(filter, 0.0);
+		if (0.0 != y && fabs(y) < DBL_MIN) count++;
+	}
+	*denormal = (double) count/nSteps;
+	
+	/* time, summing the outputs so that nothing is optimised away */
+	t = clock();
+	for (j = 0; j < nRuns; j++) {
+		filter->state[0] = start;
+		filter->state[1] = 0.0;
+		for (i = 0; i < nSteps; i++) sum += biquad_step(filter, 0.0);
+	}
+	t = clock() - t;
+	
+	if (flush) LEAVE_FTZ_DAZ(csr);
+	
+	/* keep the sum alive */
+	if (sum != sum) printf("NaN\n");
+	
+	return 1.0e9*t/CLOCKS_PER_SEC/nSteps/nRuns;
+}
+
+int main(int argc, char *argv[]) {
+	biquad filter;
+	int nSteps = 50000;
+	int nRuns = 20;
+	double tNormal;
+	double tDenormal;
+	double tFlushed;
+	double dNormal;
+	double dDenormal;
+	double dFlushed;
+	
+	if (1 < argc) nSteps = atoi(argv[1]);
+	if (2 < argc) nRuns = atoi(argv[2]);
+	if (1 > nSteps || 1 > nRuns) {
+		fprintf(stderr, "Invalid arguments: nSteps and nRuns must be positive\n");
+		return 2;
+	}
+	
+	/* 1 rad/s, 5 % damping at 100 Hz, losing a factor e every 2000 steps */
+	biquad_init(&filter, 1.0, 0.05, 0.01);
+	
+	tNormal = run(&filter, 1.0, nSteps, nRuns, 0, &dNormal);
+	tDenormal = run(&filter, DBL_MIN, nSteps, nRuns, 0, &dDenormal);
+	tFlushed = run(&filter, DBL_MIN, nSteps, nRuns, 1, &dFlushed);
+	
+	printf("normal state               %7.2f ns/step   %5.1f %% denormal\n", tNormal, 100.0*dNormal);
+	printf("denormal state             %7.2f ns/step   %5.1f %% denormal\n", tDenormal, 100.0*dDenormal);
+	printf("denormal state, FTZ/DAZ    %7.2f ns/step   %5.1f %% denormal%s\n", tFlushed, 100.0*dFlushed,
+		HAVE_FTZ_DAZ ? "" : "   (not available on this target)");
+	printf("denormal slowdown %.1fx, %.1fx with FTZ/DAZ\n", tDenormal/tNormal, tFlushed/tNormal);
+	
+	return 0;
+}
@@ -0,0 +1,168 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file ikDisconBench.c
+ *
+ * @brief DISCON call latency benchmark
+ *
+ * Calls DISCON as a simulator would, with the real controller: a first call,
+ * a number of calls at a steady operating point above rated, and a last call,
+ * and reports the wall-clock time of the first call and the mean, median, 99th
+ * percentile and largest time of the others. It is linked against the OpenDiscon
+ * library of its distribution, so that with DISTRIBUTION = DISCON it times the
+ * controller in-process, and with DISTRIBUTION = DISCON-server it times the round
+ * trip through the shim to a running @link ikClwindconServer.c @endlink, e.g.
+ * @code
+ * ikClwindconServer 1 1 &
+ * ikDisconBench 100000
+ * @endcode
+ * Usage:
+ * @code
+ * ikDisconBench [nCalls [inFile]]
+ * @endcode
+ * with 100000 calls and no controller parameter file by default.
+ */
+
+#ifndef _WIN32
+/* clock_gettime */
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#include "OpenDiscon_EXPORT.h"
+
+/* avrSWAP array length, with the logging outputs at its end */
+#define NDATA 128
+#define LOGGINGSTART 85
+#define MAXMESSAGE 256
+
+void OpenDiscon_EXPORT DISCON(float *DATA, int *FLAG, const char *INFILE, const char *OUTNAME, char *MESSAGE);
+
+/* wall-clock time in s */
+static double now(void) {
+#ifdef _WIN32
+	LARGE_INTEGER count;
+	LARGE_INTEGER frequency;
+	
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&frequency);
+	return (double) count.QuadPart/frequency.QuadPart;
+#else
+	struct timespec t;
+	
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + 1.0e-9*t.tv_nsec;
+#endif
+}
+
+static int compare(const void *a, const void *b) {
+	double x = *((const double *) a);
+	double y = *((const double *) b);
+	
+	return (x > y) - (x < y);
+}
+
+/* call DISCON, returning its flag */
+static int call(float *data, const char *inFile, char *message) {
+	int flag = 0;
+	
+	DISCON(data, &flag, inFile, "", message);
+	if (0 > flag) fprintf(stderr, "DISCON failed at t = %g s: %s\n", data[1], message);
+	
+	return flag;
+}
+
+int main(int argc, char *argv[]) {
+	float data[NDATA];
+	char message[MAXMESSAGE];
+	const char *inFile = "";
+	int nCalls = 100000;
+	double *times;
+	double first;
+	double mean = 0.0;
+	double t;
+	int i;
+	
+	if (1 < argc) nCalls = atoi(argv[1]);
+	if (2 < argc) inFile = argv[2];
+	if (1 > nCalls) {
+		fprintf(stderr, "Invalid arguments: nCalls must be positive\n");
+		return 2;
+	}
+	times = (double *) malloc(nCalls*sizeof(double));
+	if (NULL == times) {
+		fprintf(stderr, "Not enough memory for %d calls\n", nCalls);
+		return 2;
+	}
+	
+	/* a steady operating point above rated, in the units of the avrSWAP array */
+	memset(data, 0, sizeof(data));
+	data[2] = 0.01f; /* communication interval, s */
+	data[3] = 0.1f; /* measured pitch, rad */
+	data[19] = 50.0f; /* generator speed, rad/s */
+	data[20] = 1.0f; /* rotor speed, rad/s */
+	data[22] = 200.0e3f; /* measured torque, Nm */
+	data[48] = (float) MAXMESSAGE;
+	data[49] = (float) strlen(inFile);
+	data[61] = (float) (NDATA - LOGGINGSTART + 1); /* maximum number of logging outputs */
+	data[62] = (float) LOGGINGSTART; /* record number of the first logging output */
+	
+	/* first call */
+	t = now();
+	if (0 > call(data, inFile, message)) {
+		free(times);
+		return 1;
+	}
+	first = now() - t;
+	
+	/* then the steady calls, each timed */
+	data[0] = 1.0f;
+	for (i = 0; i < nCalls; i++) {
+		data[1] = (float) (0.01*(i + 1)); /* time, s */
+		data[59] = (float) (0.01*(i + 1)); /* azimuth, rad */
+		t = now();
+		if (0 > call(data, inFile, message)) {
+			free(times);
+			return 1;
+		}
+		times[i] = now() - t;
+		mean += times[i];
+	}
+	mean /= nCalls;
+	
+	/* last call */
+	data[0] = -1.0f;
+	call(data, inFile, message);
+	
+	qsort(times, nCalls, sizeof(double), compare);
+	printf("first call %.1f us\n", 1.0e6*first);
+	printf("%d calls: mean %.2f us   median %.2f us   99th percentile %.2f us   max %.2f us\n", nCalls,
+		1.0e6*mean, 1.0e6*times[nCalls/2], 1.0e6*times[(int) (0.99*(nCalls - 1))], 1.0e6*times[nCalls - 1]);
+	free(times);
+	
+	return 0;
+}
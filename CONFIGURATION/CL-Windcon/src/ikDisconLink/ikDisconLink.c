@@ -0,0 +1,255 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikDisconLink.c
+ * 
+ * @brief Class ikDisconLink implementation
+ */
+
+/* @cond */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ikDisconLink.h"
+
+#define IKDISCONLINK_MAGIC 0x4c444b49u /* "IKDL" */
+#define IKDISCONLINK_VERSION 3u
+#define IKDISCONLINK_CACHELINE 64
+/* number of checks for a reply before waiting for it */
+#define IKDISCONLINK_SPIN 4000
+/* longest single wait, in ms */
+#define IKDISCONLINK_WAIT 100
+/* avrSWAP record holding the record number of the first logging output, all records before it being controller inputs and outputs */
+#define IKDISCONLINK_LOGGINGRECORD 63
+
+/* shared memory layout: a header followed by one slot per turbine,
+   each starting at a cache line boundary */
+typedef struct ikDisconLinkHeader {
+	unsigned int magic;
+	unsigned int version;
+	unsigned int nSlots;
+	volatile unsigned int doorbell;
+	char pad[IKDISCONLINK_CACHELINE - 4*sizeof(unsigned int)];
+} ikDisconLinkHeader;
+
+typedef struct ikDisconLinkSlot {
+	volatile unsigned int owner; /* process identifier of the shim, 0 if free */
+	volatile unsigned int request; /* incremented by the shim at each call */
+	volatile unsigned int reply; /* set to request by the server when done */
+	int turbine;
+	int status;
+	int size; /* number of avrSWAP records copied in and out */
+	float data[IKDISCONLINK_NDATA];
+	char inFile[IKDISCONLINK_MAXFILE];
+	char message[IKDISCONLINK_MAXMESSAGE];
+} ikDisconLinkSlot;
+
+static ikDisconLinkHeader *ikDisconLink_header(const ikDisconLink *self) {
+	return (ikDisconLinkHeader *) self->memory.address;
+}
+
+static ikDisconLinkSlot *ikDisconLink_slot(const ikDisconLink *self, int slot) {
+	return (ikDisconLinkSlot *) ((char *) self->memory.address + sizeof(ikDisconLinkHeader) + slot*self->slotSize);
+}
+
+static int ikDisconLink_size(const float *data) {
+	double size = data[IKDISCONLINK_LOGGINGRECORD - 1] - 1.0;
+	
+	/* the logging outputs start after the logging record, if at all, so an array
+	   which does not say where is taken to end at the logging record */
+	if (IKDISCONLINK_LOGGINGRECORD > size) return IKDISCONLINK_LOGGINGRECORD;
+	if (IKDISCONLINK_NDATA < size) return IKDISCONLINK_NDATA;
+	return (int) size;
+}
+
+/* @endcond */
+
+int ikDisconLink_init(ikDisconLink *self, const ikDisconLinkParams *params) {
+	ikDisconLinkHeader *header;
+	
+	self->memory.address = NULL;
+	self->timeout = params->timeout;
+	/* round the slot size up to whole cache lines */
+	self->slotSize = (sizeof(ikDisconLinkSlot) + IKDISCONLINK_CACHELINE - 1)/IKDISCONLINK_CACHELINE*IKDISCONLINK_CACHELINE;
+	
+	if (params->create) {
+		/* create the shared memory, with all slots free */
+		if (0 >= params->nSlots) return -1;
+		self->nSlots = params->nSlots;
+		if (ikSharedMemory_create(&(self->memory), params->name, sizeof(ikDisconLinkHeader) + self->nSlots*self->slotSize)) return -2;
+		header = ikDisconLink_header(self);
+		header->nSlots = (unsigned int) self->nSlots;
+		header->doorbell = 0;
+		header->version = IKDISCONLINK_VERSION;
+		ikSharedMemory_barrier();
+		header->magic = IKDISCONLINK_MAGIC;
+	} else {
+		/* open the shared memory and check it */
+		if (ikSharedMemory_open(&(self->memory), params->name)) return -2;
+		header = ikDisconLink_header(self);
+		if (self->memory.size < sizeof(ikDisconLinkHeader) || IKDISCONLINK_MAGIC != header->magic || IKDISCONLINK_VERSION != header->version) {
+			ikDisconLink_close(self);
+			return -3;
+		}
+		self->nSlots = (int) header->nSlots;
+		if (self->memory.size < sizeof(ikDisconLinkHeader) + self->nSlots*self->slotSize) {
+			ikDisconLink_close(self);
+			return -3;
+		}
+	}
+	
+	return 0;
+}
+
+void ikDisconLink_initParams(ikDisconLinkParams *params) {
+	params->name = "OpenDisconServer";
+	params->create = 0;
+	params->nSlots = 64;
+	params->timeout = 10;
+}
+
+int ikDisconLink_claim(ikDisconLink *self, int turbine) {
+	int i;
+	ikDisconLinkSlot *slot;
+	unsigned int process = ikSharedMemory_getProcess();
+	unsigned int owner;
+	
+	/* take a free slot */
+	for (i = 0; i < self->nSlots; i++) {
+		slot = ikDisconLink_slot(self, i);
+		if (ikSharedMemory_compareAndSwap(&(slot->owner), 0u, process)) {
+			slot->turbine = turbine;
+			return i;
+		}
+	}
+	
+	/* or else one left behind by a simulator which has crashed or been killed;
+	   the first call through it sets the server's controller up anew */
+	for (i = 0; i < self->nSlots; i++) {
+		slot = ikDisconLink_slot(self, i);
+		owner = slot->owner;
+		if (0u != owner && !ikSharedMemory_isProcessAlive(owner) && ikSharedMemory_compareAndSwap(&(slot->owner), owner, process)) {
+			slot->turbine = turbine;
+			return i;
+		}
+	}
+	
+	return -1;
+}
+
+int ikDisconLink_call(ikDisconLink *self, int slot, float *data, const char *inFile, char *message) {
+	ikDisconLinkSlot *s = ikDisconLink_slot(self, slot);
+	ikDisconLinkHeader *header = ikDisconLink_header(self);
+	unsigned int request;
+	unsigned int reply;
+	int i;
+	time_t deadline;
+	int size = ikDisconLink_size(data);
+	
+	/* post the call, copying no more records than the simulator has */
+	s->size = size;
+	memcpy(s->data, data, size*sizeof(float));
+	if (NULL != inFile) {
+		strncpy(s->inFile, inFile, IKDISCONLINK_MAXFILE - 1);
+		s->inFile[IKDISCONLINK_MAXFILE - 1] = '\0';
+	}
+	request = s->request + 1;
+	ikSharedMemory_barrier();
+	s->request = request;
+	ikSharedMemory_increment(&(header->doorbell));
+	ikSharedMemory_wake(&(header->doorbell));
+	
+	/* wait for the reply, briefly spinning first since it is usually quick */
+	for (i = 0; i < IKDISCONLINK_SPIN && request != s->reply; i++);
+	deadline = time(NULL) + self->timeout;
+	while (request != (reply = s->reply)) {
+		if (time(NULL) > deadline) return -1;
+		ikSharedMemory_wait(&(s->reply), reply, IKDISCONLINK_WAIT);
+	}
+	ikSharedMemory_barrier();
+	
+	/* collect the reply */
+	memcpy(data, s->data, size*sizeof(float));
+	if (NULL != message) {
+		memcpy(message, s->message, IKDISCONLINK_MAXMESSAGE);
+		message[IKDISCONLINK_MAXMESSAGE - 1] = '\0';
+	}
+	
+	return s->status ? -2 : 0;
+}
+
+void ikDisconLink_release(ikDisconLink *self, int slot) {
+	ikDisconLinkSlot *s = ikDisconLink_slot(self, slot);
+	
+	ikSharedMemory_barrier();
+	s->owner = 0;
+}
+
+unsigned int ikDisconLink_getDoorbell(const ikDisconLink *self) {
+	return ikDisconLink_header(self)->doorbell;
+}
+
+void ikDisconLink_waitDoorbell(ikDisconLink *self, unsigned int doorbell, int timeout) {
+	ikSharedMemory_wait(&(ikDisconLink_header(self)->doorbell), doorbell, timeout);
+}
+
+int ikDisconLink_isPending(const ikDisconLink *self, int slot) {
+	ikDisconLinkSlot *s = ikDisconLink_slot(self, slot);
+	
+	if (s->request == s->reply) return 0;
+	ikSharedMemory_barrier();
+	return 1;
+}
+
+float *ikDisconLink_getData(ikDisconLink *self, int slot) {
+	return ikDisconLink_slot(self, slot)->data;
+}
+
+int ikDisconLink_getSize(const ikDisconLink *self, int slot) {
+	return ikDisconLink_slot(self, slot)->size;
+}
+
+const char *ikDisconLink_getInFile(const ikDisconLink *self, int slot) {
+	return ikDisconLink_slot(self, slot)->inFile;
+}
+
+int ikDisconLink_getTurbine(const ikDisconLink *self, int slot) {
+	return ikDisconLink_slot(self, slot)->turbine;
+}
+
+void ikDisconLink_reply(ikDisconLink *self, int slot, int status, const char *message) {
+	ikDisconLinkSlot *s = ikDisconLink_slot(self, slot);
+	
+	s->status = status;
+	if (NULL != message) {
+		strncpy(s->message, message, IKDISCONLINK_MAXMESSAGE - 1);
+		s->message[IKDISCONLINK_MAXMESSAGE - 1] = '\0';
+	} else {
+		s->message[0] = '\0';
+	}
+	ikSharedMemory_barrier();
+	s->reply = s->request;
+	ikSharedMemory_wake(&(s->reply));
+}
+
+void ikDisconLink_close(ikDisconLink *self) {
+	ikSharedMemory_close(&(self->memory));
+}
@@ -0,0 +1,216 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikDisconLink.h
+ * 
+ * @brief Class ikDisconLink interface
+ */
+
+#ifndef IKDISCONLINK_H
+#define IKDISCONLINK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ikSharedMemory.h"
+
+#define IKDISCONLINK_NDATA 128
+#define IKDISCONLINK_MAXFILE 1024
+#define IKDISCONLINK_MAXMESSAGE 256
+
+    /**
+     * @struct ikDisconLink
+     * @brief Shared memory link between DISCON shims and a controller server
+     * 
+     * This is a named shared memory region with a number of slots, each of which
+     * carries the DISCON calls of a turbine to the controller server and its replies
+     * back. The DISCON shim loaded by the simulator claims a free slot at the first call,
+     * and then, at each call, copies the avrSWAP array into it, up to the record before
+     * the logging outputs, whose start is given in record 63, and at most @link IKDISCONLINK_NDATA @endlink records, rings the server's doorbell and waits for
+     * the reply. The server runs the controller on the slot and copies the avrSWAP
+     * records back.
+     * 
+     * Waiting is done with futexes on Linux, and by yielding the processor elsewhere.
+     * 
+     * @par Methods
+     * @li @link ikDisconLink_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikDisconLink_init @endlink initialise an instance, i.e. create or open the shared memory
+     * @li @link ikDisconLink_claim @endlink claim a free slot, or reclaim one left behind by a dead shim (shim side)
+     * @li @link ikDisconLink_call @endlink make a call through a slot and wait for the reply (shim side)
+     * @li @link ikDisconLink_release @endlink release a slot (shim side)
+     * @li @link ikDisconLink_getDoorbell @endlink get the doorbell count (server side)
+     * @li @link ikDisconLink_waitDoorbell @endlink wait for the doorbell to ring (server side)
+     * @li @link ikDisconLink_isPending @endlink check whether a slot has a call waiting (server side)
+     * @li @link ikDisconLink_getData @endlink get the avrSWAP records of a slot (server side)
+     * @li @link ikDisconLink_getSize @endlink get the number of avrSWAP records copied to a slot (server side)
+     * @li @link ikDisconLink_getInFile @endlink get the controller parameter file name of a slot (server side)
+     * @li @link ikDisconLink_getTurbine @endlink get the supercontroller turbine index of a slot (server side)
+     * @li @link ikDisconLink_reply @endlink reply to the call waiting on a slot (server side)
+     * @li @link ikDisconLink_close @endlink close the shared memory
+     */
+    typedef struct ikDisconLink {
+        /**
+         * Private members
+         */
+        /* @cond */
+        ikSharedMemory memory;
+        int nSlots;
+        unsigned long slotSize;
+        int timeout;
+        /* @endcond */
+    } ikDisconLink;
+
+    /**
+     * @struct ikDisconLinkParams
+     * @brief Shared memory link initialisation parameters
+     */
+    typedef struct ikDisconLinkParams {
+        const char *name; /**<shared memory name. The default value is "OpenDisconServer".*/
+        int create; /**<whether to create the shared memory, as the server does, rather than open it, as the shims do. The default value is 0.*/
+        int nSlots; /**<number of slots, i.e. turbines, only used when creating. The default value is 64.*/
+        int timeout; /**<time to wait for a reply before giving up, in s. The default value is 10.*/
+    } ikDisconLinkParams;
+
+    /**
+     * Initialise an instance, by creating or opening the shared memory
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of slots, must be positive
+     * @li -2: the shared memory cannot be created or opened, e.g. because another server has created it
+     * @li -3: the shared memory is not a DISCON link
+     */
+    int ikDisconLink_init(ikDisconLink *self, const ikDisconLinkParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikDisconLink_initParams(ikDisconLinkParams *params);
+
+    /**
+     * Claim a free slot, or one whose owner is no longer running, e.g. because its
+     * simulator crashed without releasing it
+     * @param self instance
+     * @param turbine supercontroller turbine index, or -1 to let the server use the configured one
+     * @return slot index, or -1 if there are no free slots
+     */
+    int ikDisconLink_claim(ikDisconLink *self, int turbine);
+
+    /**
+     * Make a call through a slot and wait for the reply
+     * @param self instance
+     * @param slot slot index
+     * @param data avrSWAP array, at least up to the record before the logging outputs, whose start is given in record 63, or at least 63 records long if record 63 is not set
+     * @param inFile controller parameter file name, only sent at the first call, or NULL
+     * @param message buffer for the server's message, at least @link IKDISCONLINK_MAXMESSAGE @endlink characters long, or NULL
+     * @return error code:
+     * @li 0: no error
+     * @li -1: no reply within the timeout, e.g. because the server is not running
+     * @li -2: the server could not serve the call, as explained in the message
+     */
+    int ikDisconLink_call(ikDisconLink *self, int slot, float *data, const char *inFile, char *message);
+
+    /**
+     * Release a slot
+     * @param self instance
+     * @param slot slot index
+     */
+    void ikDisconLink_release(ikDisconLink *self, int slot);
+
+    /**
+     * Get the doorbell count, which increases with every call
+     * @param self instance
+     * @return doorbell count
+     */
+    unsigned int ikDisconLink_getDoorbell(const ikDisconLink *self);
+
+    /**
+     * Wait for the doorbell to ring, or for a timeout
+     * @param self instance
+     * @param doorbell doorbell count got before checking the slots
+     * @param timeout timeout in ms
+     */
+    void ikDisconLink_waitDoorbell(ikDisconLink *self, unsigned int doorbell, int timeout);
+
+    /**
+     * Check whether a slot has a call waiting
+     * @param self instance
+     * @param slot slot index
+     * @return 1 if a call is waiting, 0 otherwise
+     */
+    int ikDisconLink_isPending(const ikDisconLink *self, int slot);
+
+    /**
+     * Get the avrSWAP records of a slot, @link IKDISCONLINK_NDATA @endlink long
+     * @param self instance
+     * @param slot slot index
+     * @return avrSWAP records
+     */
+    float *ikDisconLink_getData(ikDisconLink *self, int slot);
+
+    /**
+     * Get the number of avrSWAP records copied to a slot at the last call, i.e.
+     * the records before the logging outputs, whose start is given in record 63, limited
+     * to @link IKDISCONLINK_NDATA @endlink, or 63 if not given. Records beyond them, e.g.
+     * the logging outputs, are not sent back.
+     * @param self instance
+     * @param slot slot index
+     * @return number of records
+     */
+    int ikDisconLink_getSize(const ikDisconLink *self, int slot);
+
+    /**
+     * Get the controller parameter file name of a slot, as sent at the first call
+     * @param self instance
+     * @param slot slot index
+     * @return file name
+     */
+    const char *ikDisconLink_getInFile(const ikDisconLink *self, int slot);
+
+    /**
+     * Get the supercontroller turbine index of a slot, as given when claimed
+     * @param self instance
+     * @param slot slot index
+     * @return turbine index, or -1
+     */
+    int ikDisconLink_getTurbine(const ikDisconLink *self, int slot);
+
+    /**
+     * Reply to the call waiting on a slot
+     * @param self instance
+     * @param slot slot index
+     * @param status 0 if the call was served, negative otherwise
+     * @param message message for the simulator, or NULL
+     */
+    void ikDisconLink_reply(ikDisconLink *self, int slot, int status, const char *message);
+
+    /**
+     * Close the shared memory, and remove it if this instance created it
+     * @param self instance
+     */
+    void ikDisconLink_close(ikDisconLink *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKDISCONLINK_H */
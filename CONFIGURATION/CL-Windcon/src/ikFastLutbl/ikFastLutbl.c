@@ -0,0 +1,210 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file ikFastLutbl.c
+ * 
+ * @brief Class ikFastLutbl implementation
+ */
+
+/* @cond */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "ikFastLutbl.h"
+
+/* the points of a table which is 0 everywhere, x, y and slope alike */
+static const double ikFastLutblTable_zero[1] = {0.0};
+
+/* find the interval of x, and its distance to the interval start,
+   which is 0 when saturated */
+static int ikFastLutbl_find(ikFastLutbl *self, double x, double *dx) {
+	int i;
+	int lo;
+	int hi;
+	const ikFastLutblTable *t = self->table;
+	
+	/* saturate, NaN included at the lower end */
+	*dx = 0.0;
+	if (!(x > t->x[0])) return 0;
+	if (x >= t->x[t->n - 1]) return t->n - 1;
+	
+	/* find the interval */
+	if (t->uniform) {
+		i = (int) ((x - t->x[0])*t->invDx);
+		i = i < 0 ? 0 : i;
+		i = i < t->n - 2 ? i : t->n - 2;
+		/* correct for rounding */
+		if (x < t->x[i] && 0 < i) i--;
+		else if (x >= t->x[i+1] && t->n - 2 > i) i++;
+	} else {
+		i = self->last;
+		if (x < t->x[i]) {
+			if (0 < i && x >= t->x[i-1]) {
+				i--;
+			} else {
+				lo = 0;
+				hi = i;
+				while (hi - lo > 1) {
+					i = (lo + hi)/2;
+					if (x >= t->x[i]) lo = i;
+					else hi = i;
+				}
+				i = lo;
+			}
+		} else if (x >= t->x[i+1]) {
+			if (t->n - 2 > i && x < t->x[i+2]) {
+				i++;
+			} else {
+				lo = i + 1;
+				hi = t->n - 1;
+				while (hi - lo > 1) {
+					i = (lo + hi)/2;
+					if (x >= t->x[i]) lo = i;
+					else hi = i;
+				}
+				i = lo;
+			}
+		}
+		self->last = i;
+	}
+	
+	*dx = x - t->x[i];
+	return i;
+}
+
+void ikFastLutblTable_init(ikFastLutblTable *self) {
+	/* make the table 0 everywhere, without allocating anything */
+	self->n = 1;
+	self->nColumns = 1;
+	self->uniform = 0;
+	self->invDx = 0.0;
+	self->x = ikFastLutblTable_zero;
+	self->y = ikFastLutblTable_zero;
+	self->slope = ikFastLutblTable_zero;
+	self->memory = NULL;
+}
+
+void ikFastLutblTable_release(ikFastLutblTable *self) {
+	free(self->memory);
+	ikFastLutblTable_init(self);
+}
+
+int ikFastLutblTable_setPoints(ikFastLutblTable *self, int n, const double *x, const double *y) {
+	return ikFastLutblTable_setColumns(self, n, 1, x, y);
+}
+
+int ikFastLutblTable_setColumns(ikFastLutblTable *self, int n, int nColumns, const double *x, const double *y) {
+	int i;
+	int j;
+	double dx;
+	double *memory;
+	double *px;
+	double *py;
+	double *pslope;
+	
+	/* check the points */
+	if (1 > n || IKFASTLUTBL_MAXPOINTS < n) return -1;
+	for (i = 1; i < n; i++) {
+		if (x[i] <= x[i-1]) return -2;
+	}
+	if (1 > nColumns || IKFASTLUTBL_MAXCOLUMNS < nColumns) return -3;
+	
+	/* allocate just enough for the points and slopes */
+	memory = (double *) malloc((n + 2*n*nColumns)*sizeof(double));
+	if (NULL == memory) return -4;
+	px = memory;
+	py = px + n;
+	pslope = py + n*nColumns;
+	
+	/* register the points and calculate the slopes */
+	for (i = 0; i < n; i++) {
+		px[i] = x[i];
+		for (j = 0; j < nColumns; j++) {
+			py[i*nColumns + j] = y[i*nColumns + j];
+		}
+	}
+	for (i = 0; i < n - 1; i++) {
+		for (j = 0; j < nColumns; j++) {
+			pslope[i*nColumns + j] = (y[(i+1)*nColumns + j] - y[i*nColumns + j])/(x[i+1] - x[i]);
+		}
+	}
+	for (j = 0; j < nColumns; j++) {
+		pslope[(n-1)*nColumns + j] = 0.0;
+	}
+	
+	/* replace the previous points, only now, in case x or y were among them */
+	free(self->memory);
+	self->memory = memory;
+	self->x = px;
+	self->y = py;
+	self->slope = pslope;
+	self->n = n;
+	self->nColumns = nColumns;
+	
+	/* check whether the x values are evenly spaced */
+	self->uniform = 0;
+	self->invDx = 0.0;
+	if (2 < n) {
+		dx = (x[n-1] - x[0])/(n - 1);
+		self->uniform = 1;
+		for (i = 1; i < n - 1; i++) {
+			if (fabs(x[i] - (x[0] + i*dx)) > 1.0e-9*(x[n-1] - x[0])) {
+				self->uniform = 0;
+				break;
+			}
+		}
+		if (self->uniform) self->invDx = 1.0/dx;
+	}
+	
+	return 0;
+}
+
+void ikFastLutbl_init(ikFastLutbl *self, const ikFastLutblTable *table) {
+	self->table = table;
+	self->last = 0;
+}
+
+double ikFastLutbl_eval(ikFastLutbl *self, double x) {
+	int i;
+	double dx;
+	
+	i = ikFastLutbl_find(self, x, &dx);
+	return self->table->y[i*self->table->nColumns] + dx*self->table->slope[i*self->table->nColumns];
+}
+
+void ikFastLutbl_evalColumns(ikFastLutbl *self, double x, double *y) {
+	int i;
+	int j;
+	double dx;
+	const double *y0;
+	const double *slope;
+	
+	i = ikFastLutbl_find(self, x, &dx);
+	
+	/* interpolate all columns at once */
+	y0 = self->table->y + i*self->table->nColumns;
+	slope = self->table->slope + i*self->table->nColumns;
+	for (j = 0; j < self->table->nColumns; j++) {
+		y[j] = y0[j] + dx*slope[j];
+	}
+}
+
+/* @endcond */
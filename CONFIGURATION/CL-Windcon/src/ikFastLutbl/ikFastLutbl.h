@@ -0,0 +1,173 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file ikFastLutbl.h
+ * 
+ * @brief Class ikFastLutbl interface
+ */
+
+#ifndef IKFASTLUTBL_H
+#define IKFASTLUTBL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IKFASTLUTBL_MAXPOINTS 256
+#define IKFASTLUTBL_MAXCOLUMNS 4
+
+    /**
+     * @struct ikFastLutblTable
+     * @brief Fast look-up table points
+     * 
+     * These are the points of an @link ikFastLutbl @endlink, together with the interval
+     * slopes and the choice of interval search, all of which are calculated when the
+     * points are set. They do not change during evaluation, so they can be shared by
+     * any number of @link ikFastLutbl @endlink instances.
+     * 
+     * The points and slopes are allocated when set, as many as there are, and freed
+     * by @link ikFastLutblTable_release @endlink.
+     * 
+     * A table may have several y columns sharing the same x values, in which case
+     * a single interval search serves all of them, and they are stored interleaved so
+     * that all columns are interpolated together.
+     * 
+     * @par Methods
+     * @li @link ikFastLutblTable_init @endlink initialise an instance
+     * @li @link ikFastLutblTable_setPoints @endlink set the table points
+     * @li @link ikFastLutblTable_setColumns @endlink set the table points, for several y columns
+     * @li @link ikFastLutblTable_release @endlink free the table points
+     */
+    typedef struct ikFastLutblTable {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int n;
+        int nColumns;
+        int uniform;
+        double invDx;
+        const double *x;
+        const double *y;
+        const double *slope;
+        double *memory;
+        /* @endcond */
+    } ikFastLutblTable;
+
+    /**
+     * @struct ikFastLutbl
+     * @brief Fast look-up table
+     * 
+     * This is a linearly interpolated look-up table, saturated at both ends, with its
+     * points in an @link ikFastLutblTable @endlink. A NaN argument gives the value at
+     * the lower end.
+     * 
+     * The interval search is chosen when the points are set:
+     * @li if the x values are evenly spaced, the interval is calculated directly
+     * @li otherwise, the search starts from the interval found on the previous evaluation and
+     * its neighbours, falling back to a binary search, so slowly varying arguments are found
+     * in constant time and large tables stay cheap
+     * 
+     * @par Methods
+     * @li @link ikFastLutbl_init @endlink initialise an instance
+     * @li @link ikFastLutbl_eval @endlink evaluate the table
+     * @li @link ikFastLutbl_evalColumns @endlink evaluate all columns of the table
+     */
+    typedef struct ikFastLutbl {
+        /**
+         * Private members
+         */
+        /* @cond */
+        const ikFastLutblTable *table;
+        int last;
+        /* @endcond */
+    } ikFastLutbl;
+
+    /**
+     * Initialise an instance, as a table which is 0 everywhere, before setting its points
+     * @param self instance
+     */
+    void ikFastLutblTable_init(ikFastLutblTable *self);
+
+    /**
+     * Set the table points
+     * @param self instance
+     * @param n number of points
+     * @param x x values, strictly increasing
+     * @param y y values
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of points, must be between 1 and IKFASTLUTBL_MAXPOINTS
+     * @li -2: invalid x values, must be strictly increasing
+     * @li -4: not enough memory, the table is left as it was
+     */
+    int ikFastLutblTable_setPoints(ikFastLutblTable *self, int n, const double *x, const double *y);
+
+    /**
+     * Set the table points, for several y columns
+     * @param self instance
+     * @param n number of points
+     * @param nColumns number of y columns
+     * @param x x values, strictly increasing
+     * @param y y values, point by point, i.e. the value of column j at point i is y[i*nColumns + j]
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of points, must be between 1 and IKFASTLUTBL_MAXPOINTS
+     * @li -2: invalid x values, must be strictly increasing
+     * @li -3: invalid number of columns, must be between 1 and IKFASTLUTBL_MAXCOLUMNS
+     * @li -4: not enough memory, the table is left as it was
+     */
+    int ikFastLutblTable_setColumns(ikFastLutblTable *self, int n, int nColumns, const double *x, const double *y);
+
+    /**
+     * Free the table points, leaving a table which is 0 everywhere, as after
+     * @link ikFastLutblTable_init @endlink. No instance may be using it.
+     * @param self instance
+     */
+    void ikFastLutblTable_release(ikFastLutblTable *self);
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param table table points, which must outlive the instance and not change while it is used
+     */
+    void ikFastLutbl_init(ikFastLutbl *self, const ikFastLutblTable *table);
+
+    /**
+     * Evaluate the table
+     * @param self instance
+     * @param x x value
+     * @return y value, of the first column
+     */
+    double ikFastLutbl_eval(ikFastLutbl *self, double x);
+
+    /**
+     * Evaluate all columns of the table
+     * @param self instance
+     * @param x x value
+     * @param y y values, one per column
+     */
+    void ikFastLutbl_evalColumns(ikFastLutbl *self, double x, double *y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKFASTLUTBL_H */
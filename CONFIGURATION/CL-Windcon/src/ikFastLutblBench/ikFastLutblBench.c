@@ -0,0 +1,176 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikFastLutblBench.c
+ *
+ * @brief Fast look-up table check and benchmark
+ *
+ * Checks @link ikFastLutbl @endlink against a brute-force reference, which scans
+ * all intervals and interpolates, on evenly and unevenly spaced tables, with
+ * arguments jumping at random and moving slowly, and reports the largest difference
+ * in units in the last place (ulp) of the largest y value. It then times both on
+ * the same arguments. It also checks that infinite arguments saturate, and that NaN
+ * gives the value at the lower end. Usage:
+ * @code
+ * ikFastLutblBench [nPoints [nEvals]]
+ * @endcode
+ * with 64 points and 1000000 evaluations by default. The exit status is 1 if any
+ * difference exceeds 1 ulp, or if a non-finite argument is not saturated.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include <time.h>
+#include "ikFastLutbl.h"
+
+/* linear scan and interpolation, as slow and obvious as it gets */
+static double reference(int n, const double *x, const double *y, double xi) {
+	int i;
+	
+	if (xi <= x[0]) return y[0];
+	if (xi >= x[n-1]) return y[n-1];
+	for (i = 0; xi >= x[i+1]; i++);
+	return y[i] + (xi - x[i])*((y[i+1] - y[i])/(x[i+1] - x[i]));
+}
+
+static double uniformRandom(double a, double b) {
+	return a + (b - a)*rand()/RAND_MAX;
+}
+
+static int run(const char *label, int n, const double *x, const double *y, const double *args, int nEvals) {
+	ikFastLutblTable table;
+	ikFastLutbl lutbl;
+	double yMax = 0.0;
+	double err = 0.0;
+	double sum = 0.0;
+	double e;
+	clock_t start;
+	double tFast;
+	double tRef;
+	int i;
+	
+	ikFastLutblTable_init(&table);
+	ikFastLutblTable_setPoints(&table, n, x, y);
+	ikFastLutbl_init(&lutbl, &table);
+	for (i = 0; i < n; i++) {
+		if (fabs(y[i]) > yMax) yMax = fabs(y[i]);
+	}
+	
+	/* compare */
+	for (i = 0; i < nEvals; i++) {
+		e = fabs(ikFastLutbl_eval(&lutbl, args[i]) - reference(n, x, y, args[i]));
+		if (e > err) err = e;
+	}
+	err /= yMax*DBL_EPSILON;
+	
+	/* time, summing the results so that nothing is optimised away */
+	start = clock();
+	for (i = 0; i < nEvals; i++) sum += ikFastLutbl_eval(&lutbl, args[i]);
+	tFast = (double) (clock() - start)/CLOCKS_PER_SEC;
+	start = clock();
+	for (i = 0; i < nEvals; i++) sum -= reference(n, x, y, args[i]);
+	tRef = (double) (clock() - start)/CLOCKS_PER_SEC;
+	
+	printf("%-24s max error %5.2f ulp   fast %7.2f ns   reference %7.2f ns   (%g)\n", label, err,
+		1.0e9*tFast/nEvals, 1.0e9*tRef/nEvals, sum);
+	ikFastLutblTable_release(&table);
+	
+	return 1.0 < err;
+}
+
+static int runNonFinite(const char *label, int n, const double *x, const double *y) {
+	ikFastLutblTable table;
+	ikFastLutbl lutbl;
+	double nan = strtod("nan", NULL);
+	double inf = strtod("inf", NULL);
+	int fail;
+	
+	ikFastLutblTable_init(&table);
+	ikFastLutblTable_setPoints(&table, n, x, y);
+	ikFastLutbl_init(&lutbl, &table);
+	
+	/* from the middle of the table, where the last interval found is no help */
+	ikFastLutbl_eval(&lutbl, 0.5);
+	fail = y[0] != ikFastLutbl_eval(&lutbl, nan);
+	ikFastLutbl_eval(&lutbl, 0.5);
+	fail |= y[0] != ikFastLutbl_eval(&lutbl, -inf);
+	ikFastLutbl_eval(&lutbl, 0.5);
+	fail |= y[n-1] != ikFastLutbl_eval(&lutbl, inf);
+	
+	printf("%-24s NaN and infinite arguments %s\n", label, fail ? "NOT saturated" : "saturated");
+	ikFastLutblTable_release(&table);
+	
+	return fail;
+}
+
+int main(int argc, char *argv[]) {
+	int n = 64;
+	int nEvals = 1000000;
+	double x[IKFASTLUTBL_MAXPOINTS];
+	double y[IKFASTLUTBL_MAXPOINTS];
+	double *jumping;
+	double *moving;
+	int fail = 0;
+	int i;
+	
+	if (1 < argc) n = atoi(argv[1]);
+	if (2 < argc) nEvals = atoi(argv[2]);
+	if (2 > n || IKFASTLUTBL_MAXPOINTS < n || 1 > nEvals) {
+		fprintf(stderr, "Invalid arguments: nPoints must be between 2 and %d, and nEvals positive\n", IKFASTLUTBL_MAXPOINTS);
+		return 2;
+	}
+	
+	jumping = (double *) malloc(nEvals*sizeof(double));
+	moving = (double *) malloc(nEvals*sizeof(double));
+	if (NULL == jumping || NULL == moving) {
+		fprintf(stderr, "Not enough memory for %d evaluations\n", nEvals);
+		return 2;
+	}
+	
+	/* arguments over the table and a little beyond, jumping at random or moving slowly */
+	srand(1);
+	for (i = 0; i < nEvals; i++) {
+		jumping[i] = uniformRandom(-0.1, 1.1);
+		moving[i] = 0.5 + 0.6*sin(2.0*3.14159265358979*i/nEvals);
+	}
+	
+	/* evenly spaced points */
+	for (i = 0; i < n; i++) {
+		x[i] = (double) i/(n - 1);
+		y[i] = uniformRandom(-1.0, 1.0);
+	}
+	fail |= run("uniform, jumping", n, x, y, jumping, nEvals);
+	fail |= run("uniform, moving", n, x, y, moving, nEvals);
+	fail |= runNonFinite("uniform, non-finite", n, x, y);
+	
+	/* unevenly spaced points */
+	x[0] = 0.0;
+	for (i = 1; i < n; i++) x[i] = x[i-1] + uniformRandom(0.1, 1.0);
+	for (i = 0; i < n; i++) x[i] /= x[n-1];
+	fail |= run("non-uniform, jumping", n, x, y, jumping, nEvals);
+	fail |= run("non-uniform, moving", n, x, y, moving, nEvals);
+	fail |= runNonFinite("non-uniform, non-finite", n, x, y);
+	
+	free(jumping);
+	free(moving);
+	
+	return fail;
+}
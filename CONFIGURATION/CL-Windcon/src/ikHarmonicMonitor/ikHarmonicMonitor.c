@@ -0,0 +1,131 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikHarmonicMonitor.c
+ * 
+ * @brief Class ikHarmonicMonitor implementation
+ */
+
+/* @cond */
+
+#include <math.h>
+
+#include "ikHarmonicMonitor.h"
+
+#define TWOPI 6.28318530717959
+
+int ikHarmonicMonitor_init(ikHarmonicMonitor *self, const ikHarmonicMonitorParams *params) {
+	int i;
+	int j;
+	
+	/* check the parameters */
+	if (1 > params->nSignals || IKHARMONICMONITOR_MAXSIGNALS < params->nSignals) return -1;
+	if (1 > params->nHarmonics || IKHARMONICMONITOR_MAXHARMONICS < params->nHarmonics) return -2;
+	for (j = 0; j < params->nHarmonics; j++) {
+		if (0.0 >= params->harmonics[j]) return -3;
+	}
+	if (0.0 >= params->T) return -4;
+	if (0.0 >= params->gearboxRatio) return -5;
+	if (0.0 >= params->revolutions) return -6;
+	
+	/* register the parameters */
+	self->T = params->T;
+	self->gearboxRatio = params->gearboxRatio;
+	self->revolutions = params->revolutions;
+	self->nSignals = params->nSignals;
+	self->nHarmonics = params->nHarmonics;
+	for (j = 0; j < self->nHarmonics; j++) {
+		self->harmonics[j] = params->harmonics[j];
+	}
+	
+	/* nothing seen yet */
+	self->started = 0;
+	self->phase = 0.0;
+	for (i = 0; i < self->nSignals; i++) {
+		self->mean[i][0] = 0.0;
+		self->mean[i][1] = 0.0;
+		for (j = 0; j < self->nHarmonics; j++) {
+			self->re[i][j][0] = 0.0;
+			self->re[i][j][1] = 0.0;
+			self->im[i][j][0] = 0.0;
+			self->im[i][j][1] = 0.0;
+		}
+	}
+	
+	return 0;
+}
+
+void ikHarmonicMonitor_initParams(ikHarmonicMonitorParams *params) {
+	params->nSignals = 1;
+	params->nHarmonics = 1;
+	params->harmonics[0] = 1.0;
+	params->T = 0.01;
+	params->gearboxRatio = 1.0;
+	params->revolutions = 4.0;
+}
+
+void ikHarmonicMonitor_step(ikHarmonicMonitor *self, const double *signals, double generatorSpeed) {
+	int i;
+	int j;
+	double dphase;
+	double alpha;
+	double d;
+	double c[IKHARMONICMONITOR_MAXHARMONICS];
+	double s[IKHARMONICMONITOR_MAXHARMONICS];
+	
+	/* start from the first sample's mean */
+	if (!self->started) {
+		self->started = 1;
+		for (i = 0; i < self->nSignals; i++) {
+			self->mean[i][0] = signals[i];
+			self->mean[i][1] = signals[i];
+		}
+	}
+	
+	/* advance the rotor phase, and set the window for the current speed */
+	dphase = fabs(generatorSpeed)/self->gearboxRatio*self->T;
+	self->phase = fmod(self->phase + dphase, TWOPI);
+	alpha = 2.0*dphase/(TWOPI*self->revolutions);
+	alpha = alpha < 1.0 ? alpha : 1.0;
+	
+	for (j = 0; j < self->nHarmonics; j++) {
+		c[j] = cos(self->harmonics[j]*self->phase);
+		s[j] = -sin(self->harmonics[j]*self->phase);
+	}
+	
+	/* demodulate and average */
+	for (i = 0; i < self->nSignals; i++) {
+		self->mean[i][0] += alpha*(signals[i] - self->mean[i][0]);
+		self->mean[i][1] += alpha*(self->mean[i][0] - self->mean[i][1]);
+		d = signals[i] - self->mean[i][1];
+		for (j = 0; j < self->nHarmonics; j++) {
+			self->re[i][j][0] += alpha*(d*c[j] - self->re[i][j][0]);
+			self->re[i][j][1] += alpha*(self->re[i][j][0] - self->re[i][j][1]);
+			self->im[i][j][0] += alpha*(d*s[j] - self->im[i][j][0]);
+			self->im[i][j][1] += alpha*(self->im[i][j][0] - self->im[i][j][1]);
+		}
+	}
+}
+
+double ikHarmonicMonitor_getAmplitude(const ikHarmonicMonitor *self, int i, int j) {
+	if (0 > i || self->nSignals <= i || 0 > j || self->nHarmonics <= j) return 0.0;
+	return 2.0*sqrt(self->re[i][j][1]*self->re[i][j][1] + self->im[i][j][1]*self->im[i][j][1]);
+}
+
+/* @endcond */
@@ -0,0 +1,146 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikHarmonicMonitor.h
+ * 
+ * @brief Class ikHarmonicMonitor interface
+ */
+
+#ifndef IKHARMONICMONITOR_H
+#define IKHARMONICMONITOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IKHARMONICMONITOR_MAXSIGNALS 16
+#define IKHARMONICMONITOR_MAXHARMONICS 4
+
+    /**
+     * @struct ikHarmonicMonitor
+     * @brief Rotor speed tracking harmonic amplitude monitor
+     * 
+     * This estimates the amplitudes of multiples (harmonics) of the rotor speed, e.g. 1P,
+     * 2P and 3P, in a number of signals, by demodulating them at the harmonics of the
+     * rotor phase, which follows the rotor speed, and averaging the result.
+     * 
+     * The rotor phase @f$\psi@f$ is integrated from the generator speed, and each signal,
+     * less its mean, is demodulated at each harmonic h and averaged over a window of a
+     * given number of rotor revolutions, made of two cascaded exponential windows:
+     * @f[
+     *  Y_h \leftarrow Y_h + \alpha \left( (x - \bar{x}) e^{-j h \psi} - Y_h \right) \qquad
+     *  X_h \leftarrow X_h + \alpha (Y_h - X_h) \qquad
+     *  \alpha = \frac{2 \Omega T}{2 \pi N}
+     * @f]
+     * where @f$\Omega@f$ is the rotor speed and N the number of revolutions. The mean is
+     * averaged likewise. The amplitude is @f$2 |X_h|@f$. The cascade keeps the other
+     * harmonics from leaking into each estimate. The window spans the same number of
+     * revolutions at any speed, and freezes at standstill.
+     * 
+     * This costs a sine and a cosine per harmonic, shared by all signals, and a few
+     * multiply-adds per signal and harmonic, at each sample.
+     * 
+     * @par Inputs
+     * @li signals: specify via @link ikHarmonicMonitor_step @endlink
+     * @li generator speed: generator speed, in rad/s, from which the rotor speed is calculated, specify via @link ikHarmonicMonitor_step @endlink
+     * 
+     * @par Outputs
+     * @li amplitudes: get via @link ikHarmonicMonitor_getAmplitude @endlink
+     * 
+     * @par Methods
+     * @li @link ikHarmonicMonitor_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikHarmonicMonitor_init @endlink initialise an instance
+     * @li @link ikHarmonicMonitor_step @endlink execute periodic calculations
+     * @li @link ikHarmonicMonitor_getAmplitude @endlink get a harmonic amplitude
+     */
+    typedef struct ikHarmonicMonitor {
+        /**
+         * Private members
+         */
+        /* @cond */
+        double T;
+        double gearboxRatio;
+        double revolutions;
+        int nSignals;
+        int nHarmonics;
+        double harmonics[IKHARMONICMONITOR_MAXHARMONICS];
+        int started;
+        double phase;
+        double mean[IKHARMONICMONITOR_MAXSIGNALS][2];
+        double re[IKHARMONICMONITOR_MAXSIGNALS][IKHARMONICMONITOR_MAXHARMONICS][2];
+        double im[IKHARMONICMONITOR_MAXSIGNALS][IKHARMONICMONITOR_MAXHARMONICS][2];
+        /* @endcond */
+    } ikHarmonicMonitor;
+
+    /**
+     * @struct ikHarmonicMonitorParams
+     * @brief Rotor speed tracking harmonic amplitude monitor initialisation parameters
+     */
+    typedef struct ikHarmonicMonitorParams {
+        int nSignals; /**<number of signals. The default value is 1*/
+        int nHarmonics; /**<number of harmonics. The default value is 1*/
+        double harmonics[IKHARMONICMONITOR_MAXHARMONICS]; /**<harmonics, as multiples of the rotor speed, e.g. 1 for 1P or 3 for 3P. The default value is 1.0*/
+        double T; /**<sampling interval, in s. The default value is 0.01*/
+        double gearboxRatio; /**<gearbox ratio, dimensionless. The default value is 1.0*/
+        double revolutions; /**<window length, in rotor revolutions. The default value is 4.0*/
+    } ikHarmonicMonitorParams;
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of signals, must be between 1 and IKHARMONICMONITOR_MAXSIGNALS
+     * @li -2: invalid number of harmonics, must be between 1 and IKHARMONICMONITOR_MAXHARMONICS
+     * @li -3: invalid harmonic, must be positive
+     * @li -4: invalid sampling interval, must be positive
+     * @li -5: invalid gearbox ratio, must be positive
+     * @li -6: invalid window length, must be positive
+     */
+    int ikHarmonicMonitor_init(ikHarmonicMonitor *self, const ikHarmonicMonitorParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikHarmonicMonitor_initParams(ikHarmonicMonitorParams *params);
+
+    /**
+     * Execute periodic calculations
+     * @param self instance
+     * @param signals signals, as many as configured
+     * @param generatorSpeed generator speed, in rad/s
+     */
+    void ikHarmonicMonitor_step(ikHarmonicMonitor *self, const double *signals, double generatorSpeed);
+
+    /**
+     * Get a harmonic amplitude
+     * @param self instance
+     * @param i signal index
+     * @param j harmonic index
+     * @return amplitude, or 0 if an index is invalid
+     */
+    double ikHarmonicMonitor_getAmplitude(const ikHarmonicMonitor *self, int i, int j);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKHARMONICMONITOR_H */
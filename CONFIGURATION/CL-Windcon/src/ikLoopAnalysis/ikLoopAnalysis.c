@@ -0,0 +1,210 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file ikLoopAnalysis.c
+ * 
+ * @brief Class ikLoopAnalysis implementation
+ */
+
+/* @cond */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "ikLoopAnalysis.h"
+
+#define PI 3.14159265358979
+
+/* number of slots in the transfer function and notch lists */
+#define NTFS(list) ((int) (sizeof((list).tfParams)/sizeof((list).tfParams[0])))
+#define NNOTCHES(list) ((int) (sizeof((list).notchParams)/sizeof((list).notchParams[0])))
+
+static void mulBiquad(ikLoopAnalysis *self, const double *b, const double *a) {
+	int k;
+	double nre, nim, dre, dim, den, hre, him, re;
+
+	for (k = 0; k < self->n; k++) {
+		nre = b[0] + b[1]*self->z1re[k] + b[2]*self->z2re[k];
+		nim = b[1]*self->z1im[k] + b[2]*self->z2im[k];
+		dre = a[0] + a[1]*self->z1re[k] + a[2]*self->z2re[k];
+		dim = a[1]*self->z1im[k] + a[2]*self->z2im[k];
+		den = dre*dre + dim*dim;
+		hre = (nre*dre + nim*dim)/den;
+		him = (nim*dre - nre*dim)/den;
+		re = self->re[k]*hre - self->im[k]*him;
+		self->im[k] = self->re[k]*him + self->im[k]*hre;
+		self->re[k] = re;
+	}
+}
+
+static void mulNotch(ikLoopAnalysis *self, double w0, double dnum, double dden) {
+	int k;
+	double c, W, nre, nim, dim, den, hre, him, re;
+
+	/* analogue frequency corresponding to each grid frequency, prewarped at w0 */
+	c = w0/tan(w0*self->T/2.0);
+	for (k = 0; k < self->n; k++) {
+		W = c*self->tanw[k];
+		nre = w0*w0 - W*W;
+		nim = 2.0*dnum*w0*W;
+		dim = 2.0*dden*w0*W;
+		den = nre*nre + dim*dim;
+		hre = (nre*nre + nim*dim)/den;
+		him = (nim*nre - nre*dim)/den;
+		re = self->re[k]*hre - self->im[k]*him;
+		self->im[k] = self->re[k]*him + self->im[k]*hre;
+		self->re[k] = re;
+	}
+}
+
+int ikLoopAnalysis_init(ikLoopAnalysis *self, const ikLoopAnalysisParams *params) {
+	int k;
+	
+	/* register parameter values */
+	if (0.0 >= params->T) return -1;
+	self->T = params->T;
+	if (2 > params->n || IKLOOPANALYSIS_MAXPOINTS < params->n) return -2;
+	self->n = params->n;
+	if (0.0 >= params->minFreq || params->maxFreq <= params->minFreq || PI/params->T <= params->maxFreq) return -3;
+	
+	/* build the frequency grid and precalculate z^-1 and z^-2 */
+	for (k = 0; k < self->n; k++) {
+		self->w[k] = params->minFreq * pow(params->maxFreq/params->minFreq, ((double) k)/(self->n - 1));
+		self->tanw[k] = tan(self->w[k]*self->T/2.0);
+		self->z1re[k] = cos(self->w[k]*self->T);
+		self->z1im[k] = -sin(self->w[k]*self->T);
+		self->z2re[k] = cos(2.0*self->w[k]*self->T);
+		self->z2im[k] = -sin(2.0*self->w[k]*self->T);
+		self->re[k] = 1.0;
+		self->im[k] = 0.0;
+	}
+
+	return 0;
+}
+
+void ikLoopAnalysis_initParams(ikLoopAnalysisParams *params) {
+	params->T = 0.01;
+	params->n = 512;
+	params->minFreq = 0.01;
+	params->maxFreq = 100.0;
+}
+
+void ikLoopAnalysis_evalLoop(ikLoopAnalysis *self, const ikConLoopParams *loop, double gain, const double *plantRe, const double *plantIm) {
+	int i;
+	int k;
+	
+	/* start with the gain and the plant */
+	for (k = 0; k < self->n; k++) {
+		self->re[k] = NULL == plantRe ? gain : gain*plantRe[k];
+		self->im[k] = NULL == plantIm ? 0.0 : gain*plantIm[k];
+	}
+	
+	/* measurement notches */
+	for (i = 0; i < NNOTCHES(loop->linearController.measurementNotches); i++) {
+		if (!loop->linearController.measurementNotches.notchParams[i].enable) continue;
+		mulNotch(self, loop->linearController.measurementNotches.notchParams[i].freq, loop->linearController.measurementNotches.notchParams[i].dampNum, loop->linearController.measurementNotches.notchParams[i].dampDen);
+	}
+	
+	/* measurement, error and post-gain transfer functions */
+	for (i = 0; i < NTFS(loop->linearController.measurementTfs); i++) {
+		if (!loop->linearController.measurementTfs.tfParams[i].enable) continue;
+		mulBiquad(self, loop->linearController.measurementTfs.tfParams[i].b, loop->linearController.measurementTfs.tfParams[i].a);
+	}
+	for (i = 0; i < NTFS(loop->linearController.errorTfs); i++) {
+		if (!loop->linearController.errorTfs.tfParams[i].enable) continue;
+		mulBiquad(self, loop->linearController.errorTfs.tfParams[i].b, loop->linearController.errorTfs.tfParams[i].a);
+	}
+	for (i = 0; i < NTFS(loop->linearController.postGainTfs); i++) {
+		if (!loop->linearController.postGainTfs.tfParams[i].enable) continue;
+		mulBiquad(self, loop->linearController.postGainTfs.tfParams[i].b, loop->linearController.postGainTfs.tfParams[i].a);
+	}
+}
+
+void ikLoopAnalysis_getMargins(const ikLoopAnalysis *self, ikLoopMargins *margins) {
+	int k;
+	double mag0, mag1, f, re, im, pm, gm;
+	
+	margins->gainMargin = HUGE_VAL;
+	margins->phaseCrossover = 0.0;
+	margins->phaseMargin = HUGE_VAL;
+	margins->gainCrossover = 0.0;
+	
+	for (k = 1; k < self->n; k++) {
+		/* gain crossover, lowest frequency only */
+		mag0 = sqrt(self->re[k-1]*self->re[k-1] + self->im[k-1]*self->im[k-1]);
+		mag1 = sqrt(self->re[k]*self->re[k] + self->im[k]*self->im[k]);
+		if (HUGE_VAL == margins->phaseMargin && (mag0 - 1.0)*(mag1 - 1.0) <= 0.0 && mag0 != mag1) {
+			f = (1.0 - mag0)/(mag1 - mag0);
+			re = self->re[k-1] + f*(self->re[k] - self->re[k-1]);
+			im = self->im[k-1] + f*(self->im[k] - self->im[k-1]);
+			pm = 180.0 + atan2(im, re)*180.0/PI;
+			margins->phaseMargin = pm > 180.0 ? pm - 360.0 : pm;
+			margins->gainCrossover = self->w[k-1]*pow(self->w[k]/self->w[k-1], f);
+		}
+		
+		/* phase crossover, i.e. the response crosses the negative real axis */
+		if (self->im[k-1]*self->im[k] <= 0.0 && self->im[k-1] != self->im[k]) {
+			f = self->im[k-1]/(self->im[k-1] - self->im[k]);
+			re = self->re[k-1] + f*(self->re[k] - self->re[k-1]);
+			if (0.0 > re) {
+				gm = -20.0*log10(-re);
+				if (gm < margins->gainMargin) {
+					margins->gainMargin = gm;
+					margins->phaseCrossover = self->w[k-1]*pow(self->w[k]/self->w[k-1], f);
+				}
+			}
+		}
+	}
+}
+
+int ikLoopAnalysis_evalSchedule(ikLoopAnalysis *self, const ikConLoopParams *loop, ikLoopAnalysisPlant plant, void *data, ikLoopMargins *margins, int maxMargins) {
+	int i;
+	
+	/* no more points than there is room for */
+	for (i = 0; i < loop->linearController.gainSchedN && i < maxMargins; i++) {
+		if (NULL != plant) {
+			plant(loop->linearController.gainSchedX[i], self->n, self->w, self->plantRe, self->plantIm, data);
+			ikLoopAnalysis_evalLoop(self, loop, loop->linearController.gainSchedY[i], self->plantRe, self->plantIm);
+		} else {
+			ikLoopAnalysis_evalLoop(self, loop, loop->linearController.gainSchedY[i], NULL, NULL);
+		}
+		ikLoopAnalysis_getMargins(self, &(margins[i]));
+	}
+	
+	return loop->linearController.gainSchedN;
+}
+
+double ikLoopAnalysis_getNotchAttenuation(const ikConLoopParams *loop, int i) {
+	
+	/* at its own frequency, the notch gain is the ratio of the damping factors */
+	if (0 > i || NNOTCHES(loop->linearController.measurementNotches) <= i) return 0.0;
+	if (!loop->linearController.measurementNotches.notchParams[i].enable) return 0.0;
+	return -20.0*log10(fabs(loop->linearController.measurementNotches.notchParams[i].dampNum/loop->linearController.measurementNotches.notchParams[i].dampDen));
+}
+
+int ikLoopAnalysis_getPoint(const ikLoopAnalysis *self, int i, double *w, double *re, double *im) {
+	if (0 > i || self->n <= i) return -1;
+	*w = self->w[i];
+	*re = self->re[i];
+	*im = self->im[i];
+	return 0;
+}
+
+/* @endcond */
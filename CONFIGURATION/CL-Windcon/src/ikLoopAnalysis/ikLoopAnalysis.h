@@ -0,0 +1,194 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file ikLoopAnalysis.h
+ * 
+ * @brief Class ikLoopAnalysis interface
+ */
+
+#ifndef IKLOOPANALYSIS_H
+#define IKLOOPANALYSIS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    
+#include "ikConLoop.h"
+
+#define IKLOOPANALYSIS_MAXPOINTS 1024
+
+    /**
+     * Plant frequency response callback
+     * @param x gain schedule abscissa (e.g. collective pitch, in degrees) at which the plant is linearised
+     * @param n number of frequencies
+     * @param w frequencies, in rad/s
+     * @param re real part of the plant frequency response, to be filled in
+     * @param im imaginary part of the plant frequency response, to be filled in
+     * @param data user data
+     */
+    typedef void (*ikLoopAnalysisPlant)(double x, int n, const double *w, double *re, double *im, void *data);
+
+    /**
+     * @struct ikLoopMargins
+     * @brief Stability margins of an open loop frequency response
+     */
+    typedef struct ikLoopMargins {
+        double gainMargin; /**<gain margin, in dB, HUGE_VAL if there is no phase crossover on the grid*/
+        double phaseCrossover; /**<frequency at which the gain margin is found, in rad/s*/
+        double phaseMargin; /**<phase margin, in degrees, HUGE_VAL if there is no gain crossover on the grid*/
+        double gainCrossover; /**<frequency at which the phase margin is found, in rad/s*/
+    } ikLoopMargins;
+
+    /**
+     * @struct ikLoopAnalysis
+     * @brief Control loop frequency response analyser
+     * 
+     * This evaluates the discrete frequency response of a control loop directly from
+     * its initialisation parameters, i.e. the biquads in the error, measurement and
+     * post-gain transfer function lists and the measurement notches, combined with a
+     * linearised plant, and reports the stability margins.
+     * 
+     * The frequency grid is logarithmic and fixed at initialisation, and all trigonometry
+     * is done then, so evaluating a candidate tuning costs a few complex multiply-adds per
+     * frequency and stage, laid out as separate real and imaginary arrays for the compiler
+     * to vectorise.
+     * 
+     * Notches are evaluated assuming a bilinear discretisation prewarped at the notch frequency.
+     * 
+     * @par Methods
+     * @li @link ikLoopAnalysis_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikLoopAnalysis_init @endlink initialise an instance
+     * @li @link ikLoopAnalysis_evalLoop @endlink evaluate an open loop frequency response
+     * @li @link ikLoopAnalysis_getMargins @endlink get the stability margins of the last evaluated response
+     * @li @link ikLoopAnalysis_evalSchedule @endlink get the stability margins at each gain schedule point
+     * @li @link ikLoopAnalysis_getNotchAttenuation @endlink get the attenuation of a notch at its frequency
+     * @li @link ikLoopAnalysis_getPoint @endlink get a point of the last evaluated response
+     */
+    typedef struct ikLoopAnalysis {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int n;
+        double T;
+        double w[IKLOOPANALYSIS_MAXPOINTS];
+        double tanw[IKLOOPANALYSIS_MAXPOINTS];
+        double z1re[IKLOOPANALYSIS_MAXPOINTS];
+        double z1im[IKLOOPANALYSIS_MAXPOINTS];
+        double z2re[IKLOOPANALYSIS_MAXPOINTS];
+        double z2im[IKLOOPANALYSIS_MAXPOINTS];
+        double plantRe[IKLOOPANALYSIS_MAXPOINTS];
+        double plantIm[IKLOOPANALYSIS_MAXPOINTS];
+        double re[IKLOOPANALYSIS_MAXPOINTS];
+        double im[IKLOOPANALYSIS_MAXPOINTS];
+        /* @endcond */
+    } ikLoopAnalysis;
+
+    /**
+     * @struct ikLoopAnalysisParams
+     * @brief Control loop frequency response analyser initialisation parameters
+     */
+    typedef struct ikLoopAnalysisParams {
+        double T; /**<sampling interval of the analysed loops, in s. The default value is 0.01*/
+        int n; /**<number of frequencies, at most IKLOOPANALYSIS_MAXPOINTS. The default value is 512*/
+        double minFreq; /**<lowest frequency, in rad/s. The default value is 0.01*/
+        double maxFreq; /**<highest frequency, in rad/s, below the Nyquist frequency. The default value is 100.0*/
+    } ikLoopAnalysisParams;
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid sampling interval, must be positive
+     * @li -2: invalid number of frequencies, must be between 2 and IKLOOPANALYSIS_MAXPOINTS
+     * @li -3: invalid frequency range, must be positive, increasing and below the Nyquist frequency
+     */
+    int ikLoopAnalysis_init(ikLoopAnalysis *self, const ikLoopAnalysisParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikLoopAnalysis_initParams(ikLoopAnalysisParams *params);
+
+    /**
+     * Evaluate the open loop frequency response
+     * 
+     * The open loop is the product of the measurement notches, the measurement transfer
+     * functions, the error transfer functions, the gain, the post-gain transfer functions
+     * and the plant.
+     * @param self instance
+     * @param loop control loop initialisation parameters
+     * @param gain gain schedule gain
+     * @param plantRe real part of the plant frequency response at the grid frequencies, NULL for unity
+     * @param plantIm imaginary part of the plant frequency response at the grid frequencies, NULL for unity
+     */
+    void ikLoopAnalysis_evalLoop(ikLoopAnalysis *self, const ikConLoopParams *loop, double gain, const double *plantRe, const double *plantIm);
+
+    /**
+     * Get the stability margins of the last evaluated open loop frequency response.
+     * The phase margin is taken at the lowest gain crossover and the gain margin is
+     * the smallest one over all phase crossovers.
+     * @param self instance
+     * @param margins stability margins
+     */
+    void ikLoopAnalysis_getMargins(const ikLoopAnalysis *self, ikLoopMargins *margins);
+
+    /**
+     * Get the stability margins at each point of the gain schedule of a control loop,
+     * or at the first maxMargins points if there are more
+     * @param self instance
+     * @param loop control loop initialisation parameters
+     * @param plant plant frequency response callback, called once per gain schedule point
+     * @param data user data for the plant callback
+     * @param margins stability margins, one per gain schedule point
+     * @param maxMargins length of margins
+     * @return number of gain schedule points, more than maxMargins if not all were evaluated
+     */
+    int ikLoopAnalysis_evalSchedule(ikLoopAnalysis *self, const ikConLoopParams *loop, ikLoopAnalysisPlant plant, void *data, ikLoopMargins *margins, int maxMargins);
+
+    /**
+     * Get the attenuation of a measurement notch at its own frequency
+     * @param loop control loop initialisation parameters
+     * @param i notch index
+     * @return attenuation, in dB, 0 if the notch is disabled or there is no such notch
+     */
+    double ikLoopAnalysis_getNotchAttenuation(const ikConLoopParams *loop, int i);
+
+    /**
+     * Get a point of the last evaluated open loop frequency response
+     * @param self instance
+     * @param i point index
+     * @param w frequency, in rad/s
+     * @param re real part
+     * @param im imaginary part
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid point index
+     */
+    int ikLoopAnalysis_getPoint(const ikLoopAnalysis *self, int i, double *w, double *re, double *im);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKLOOPANALYSIS_H */
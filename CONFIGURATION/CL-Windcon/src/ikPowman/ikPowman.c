@@ -27,11 +27,43 @@ along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdlib.h>
 #include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
 
 #include "ikPowman.h"
 
-int ikPowman_init(ikPowman *self, const ikPowmanParams *params) {
+/* derating table columns */
+#define IKPOWMAN_KOPT 0
+#define IKPOWMAN_PITCH 1
+#define IKPOWMAN_NCOLUMNS 2
+
+/* atomically add to the number of users, which may be on different threads */
+static int ikPowmanTuning_addUsers(ikPowmanTuning *self, int n) {
+#ifdef _WIN32
+	return (int) InterlockedExchangeAdd((volatile LONG *) &(self->users), (LONG) n) + n;
+#else
+	return __sync_add_and_fetch(&(self->users), n);
+#endif
+}
+
+static int ikPowmanTuning_fail(ikPowmanTuning *self, int err) {
+	ikFastLutblTable_release(&(self->derating));
+	return err;
+}
+
+int ikPowmanTuning_init(ikPowmanTuning *self, const ikPowmanParams *params) {
 	int err;
+	int i;
+	int j;
+	int n;
+	double x[IKFASTLUTBL_MAXPOINTS];
+	double y[IKFASTLUTBL_MAXPOINTS*IKPOWMAN_NCOLUMNS];
+	ikFastLutbl lutbl;
+	
+	/* nobody uses it yet, and nothing is allocated yet */
+	self->users = 0;
+	ikFastLutblTable_init(&(self->derating));
 	
 	/* register rated power */
 	self->ratedPower = params->ratedPower;
@@ -40,18 +72,76 @@ int ikPowman_init(ikPowman *self, const ikPowmanParams *params) {
 	if (0 == params->efficiency) return -1;
 	self->efficiency = params->efficiency;
 	
-	/* initialise look-up tables */
-	ikLutbl_init(&(self->lutblKopt));
-	err = ikLutbl_setPoints(&(self->lutblKopt), params->belowRatedTorqueGainTableN, params->belowRatedTorqueGainTableX, params->belowRatedTorqueGainTableY);
-	if (err) return -2;
+	/* check the look-up tables */
+	err = ikFastLutblTable_setPoints(&(self->derating), params->belowRatedTorqueGainTableN, params->belowRatedTorqueGainTableX, params->belowRatedTorqueGainTableY);
+	if (err) return ikPowmanTuning_fail(self, -4 == err ? -5 : -2);
+	err = ikFastLutblTable_setPoints(&(self->derating), params->minimumPitchTableN, params->minimumPitchTableX, params->minimumPitchTableY);
+	if (err) return ikPowmanTuning_fail(self, -4 == err ? -5 : -3);
+	
+	/* merge the derating ratios of both tables */
+	i = 0;
+	j = 0;
+	n = 0;
+	while (i < params->belowRatedTorqueGainTableN || j < params->minimumPitchTableN) {
+		if (IKFASTLUTBL_MAXPOINTS <= n) return ikPowmanTuning_fail(self, -4);
+		if (j >= params->minimumPitchTableN || (i < params->belowRatedTorqueGainTableN && params->belowRatedTorqueGainTableX[i] < params->minimumPitchTableX[j])) {
+			x[n] = params->belowRatedTorqueGainTableX[i++];
+		} else if (i >= params->belowRatedTorqueGainTableN || params->minimumPitchTableX[j] < params->belowRatedTorqueGainTableX[i]) {
+			x[n] = params->minimumPitchTableX[j++];
+		} else {
+			x[n] = params->belowRatedTorqueGainTableX[i++];
+			j++;
+		}
+		n++;
+	}
+	
+	/* resample both tables on the merged derating ratios, which is exact,
+	   as both are piecewise linear with breakpoints among them */
+	if (ikFastLutblTable_setPoints(&(self->derating), params->belowRatedTorqueGainTableN, params->belowRatedTorqueGainTableX, params->belowRatedTorqueGainTableY)) return ikPowmanTuning_fail(self, -5);
+	ikFastLutbl_init(&lutbl, &(self->derating));
+	for (i = 0; i < n; i++) y[i*IKPOWMAN_NCOLUMNS + IKPOWMAN_KOPT] = ikFastLutbl_eval(&lutbl, x[i]);
+	if (ikFastLutblTable_setPoints(&(self->derating), params->minimumPitchTableN, params->minimumPitchTableX, params->minimumPitchTableY)) return ikPowmanTuning_fail(self, -5);
+	ikFastLutbl_init(&lutbl, &(self->derating));
+	for (i = 0; i < n; i++) y[i*IKPOWMAN_NCOLUMNS + IKPOWMAN_PITCH] = ikFastLutbl_eval(&lutbl, x[i]);
 	
-	ikLutbl_init(&(self->lutblPitch));
-	err = ikLutbl_setPoints(&(self->lutblPitch), params->minimumPitchTableN, params->minimumPitchTableX, params->minimumPitchTableY);
-	if (err) return -3;
+	/* initialise the merged look-up table */
+	err = ikFastLutblTable_setColumns(&(self->derating), n, IKPOWMAN_NCOLUMNS, x, y);
+	if (err) return ikPowmanTuning_fail(self, -5);
 	
 	return 0;
 }
 
+void ikPowmanTuning_release(ikPowmanTuning *self) {
+	ikFastLutblTable_release(&(self->derating));
+}
+
+int ikPowmanTuning_getUsers(const ikPowmanTuning *self) {
+	return self->users;
+}
+
+void ikPowman_init(ikPowman *self, ikPowmanTuning *tuning) {
+	/* register the tuning */
+	self->tuning = tuning;
+	ikPowmanTuning_addUsers(tuning, 1);
+	ikFastLutbl_init(&(self->lutblDerating), &(tuning->derating));
+	
+	/* start with an empty cache */
+	self->cacheValid = 0;
+	self->steps = 0;
+	self->cacheHits = 0;
+}
+
+int ikPowman_release(ikPowman *self) {
+	int users;
+	
+	/* unregister the tuning */
+	if (NULL == self->tuning) return 0;
+	users = ikPowmanTuning_addUsers(self->tuning, -1);
+	self->tuning = NULL;
+	
+	return users;
+}
+
 void ikPowman_initParams(ikPowmanParams *params) {
 	/* set power to 0 */
 	params->ratedPower = 0.0;
@@ -71,19 +161,35 @@ void ikPowman_initParams(ikPowmanParams *params) {
 }
 
 double ikPowman_step(ikPowman *self, double deratingRatio, double maxSpeed, double measuredSpeed) {
-	/* register inputs */
-	self->deratingRatio = deratingRatio;
-	self->maxSpeed = maxSpeed;
-	self->measuredSpeed = measuredSpeed;
+	double y[IKPOWMAN_NCOLUMNS];
 	
-	/* calculate maximum torque */	
-	self->maximumTorque = (1-deratingRatio)*self->ratedPower/maxSpeed/self->efficiency;
+	/* check whether the cached values are still valid */
+	self->steps++;
+	if (self->cacheValid
+			&& !memcmp(&deratingRatio, &(self->deratingRatio), sizeof(double))
+			&& !memcmp(&maxSpeed, &(self->maxSpeed), sizeof(double))) {
+		self->cacheHits++;
+	} else {
+		/* register inputs */
+		self->deratingRatio = deratingRatio;
+		self->maxSpeed = maxSpeed;
+		
+		/* calculate maximum torque */	
+		self->maximumTorque = (1-deratingRatio)*self->tuning->ratedPower/maxSpeed/self->tuning->efficiency;
+		
+		/* evaluate the derating table */
+		ikFastLutbl_evalColumns(&(self->lutblDerating), deratingRatio, y);
+		self->belowRatedTorqueGain = y[IKPOWMAN_KOPT];
+		self->minimumPitch = y[IKPOWMAN_PITCH];
+		
+		self->cacheValid = 1;
+	}
 	
-	/* calculate below rated torque */
-	self->belowRatedTorque = ikLutbl_eval(&(self->lutblKopt), deratingRatio)*measuredSpeed*measuredSpeed;
+	/* register measured speed */
+	self->measuredSpeed = measuredSpeed;
 	
-	/* calculate minimum pitch */
-	self->minimumPitch = ikLutbl_eval(&(self->lutblPitch), deratingRatio);
+	/* calculate below rated torque */
+	self->belowRatedTorque = self->belowRatedTorqueGain*measuredSpeed*measuredSpeed;
 	
 	/* return the maximum torque */
 	return self->maximumTorque;
@@ -115,8 +221,27 @@ int ikPowman_getOutput(const ikPowman *self, double *output, const char *name) {
         *output = self->minimumPitch;
         return 0;
     }
+    if (!strcmp(name, "cache hits")) {
+        *output = (double) self->cacheHits;
+        return 0;
+    }
+    if (!strcmp(name, "cache hit rate")) {
+        *output = self->steps ? (double) self->cacheHits/self->steps : 0.0;
+        return 0;
+    }
 	
 	return -1;
 }
 
+double ikPowman_evalMinimumPitch(const ikPowman *self, double deratingRatio) {
+	double y[IKPOWMAN_NCOLUMNS];
+	ikFastLutbl lutbl;
+	
+	/* evaluate the derating table with a look-up of our own */
+	ikFastLutbl_init(&lutbl, &(self->tuning->derating));
+	ikFastLutbl_evalColumns(&lutbl, deratingRatio, y);
+	
+	return y[IKPOWMAN_PITCH];
+}
+
 /* @endcond */
@@ -30,7 +30,33 @@ along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
 extern "C" {
 #endif
     
-#include "ikLutbl.h"
+#include "ikFastLutbl.h"
+    
+    /**
+     * @struct ikPowmanTuning
+     * @brief Power manager tuning
+     * 
+     * This is the part of the power manager which does not change after initialisation,
+     * i.e. the rated power, the efficiency and the derating table. It can be shared by
+     * any number of @link ikPowman @endlink instances, e.g. for identical turbines, which
+     * then only hold their own state.
+     * 
+     * @par Methods
+     * @li @link ikPowmanTuning_init @endlink initialise an instance
+     * @li @link ikPowmanTuning_getUsers @endlink get the number of power managers using it
+     * @li @link ikPowmanTuning_release @endlink free the derating table
+     */
+    typedef struct ikPowmanTuning {
+        /**
+         * Private members
+         */
+        /* @cond */
+		double ratedPower;
+		double efficiency;
+		ikFastLutblTable derating;
+		volatile int users;
+        /* @endcond */
+    } ikPowmanTuning;
     
     /**
      * @struct ikPowman
@@ -38,6 +64,14 @@ extern "C" {
      * 
      * This is the above-below rated state machine.
      * 
+     * The below rated torque gain and minimum pitch tables are merged into a single
+     * table with one derating ratio axis and two columns, so that they are evaluated
+     * with a single search.
+     * 
+     * The derating ratio and maximum speed change seldom, so the maximum torque and
+     * the table values are only recalculated when either of them differs, bit by bit,
+     * from its value at the previous step. Otherwise, the cached values are reused.
+     * 
      * @par Inputs
      * @li derating ratio: proportion of producible power to be deducted from production, non-dimensional, specify via @link ikPowman_step @endlink
      * @li maximum speed: maximum generator speed setpoint, in rad/s, specify via @link ikPowman_step @endlink
@@ -47,6 +81,8 @@ extern "C" {
      * @li maximum torque: upper torque limit, in kNm, get via @link ikPowman_getOutput @endlink
 	 * @li below rated torque: preferred torque below rated wind speed, in kNm, get via @link ikPowman_getOutput @endlink
      * @li minimum pitch: lower pitch angle limit, in degrees, get via @link ikPowman_getOutput @endlink
+     * @li cache hits: number of steps which reused the cached values, get via @link ikPowman_getOutput @endlink
+     * @li cache hit rate: proportion of steps which reused the cached values, non-dimensional, get via @link ikPowman_getOutput @endlink
      * 
      * @par Unit block
      * 
@@ -59,24 +95,28 @@ extern "C" {
      * @par Methods
      * @li @link ikPowman_initParams @endlink initialise initialisation parameter structure
      * @li @link ikPowman_init @endlink initialise an instance
+     * @li @link ikPowman_release @endlink stop using the tuning
      * @li @link ikPowman_step @endlink execute periodic calculations
      * @li @link ikPowman_getOutput @endlink get output value
+     * @li @link ikPowman_evalMinimumPitch @endlink evaluate the minimum pitch for a derating ratio, without stepping
      */
     typedef struct ikPowman {
         /**
          * Private members
          */
         /* @cond */
-		double ratedPower;
-		double efficiency;
-		ikLutbl lutblKopt;
-		ikLutbl lutblPitch;
+		ikPowmanTuning *tuning;
+		ikFastLutbl lutblDerating;
 		double deratingRatio;
 		double maxSpeed;
 		double measuredSpeed;
 		double maximumTorque;
 		double belowRatedTorque;
 		double minimumPitch;
+		int cacheValid;
+		double belowRatedTorqueGain;
+		unsigned long steps;
+		unsigned long cacheHits;
         /* @endcond */
     } ikPowman;
     
@@ -89,29 +129,61 @@ extern "C" {
 		double				efficiency; /**<drivetrain and generator efficiency, non-dimensional*/
 		int                 belowRatedTorqueGainTableN;                     /**<number of points defining the below rated torque gain table.
                                                                                      The default value is 1.*/
-        double              belowRatedTorqueGainTableX 	[IKLUTBL_MAXPOINTS];/**<derating ratios defining the below rated torque gain table, non-dimensional.
+        double              belowRatedTorqueGainTableX 	[IKFASTLUTBL_MAXPOINTS];/**<derating ratios defining the below rated torque gain table, non-dimensional.
                                                                                      The default value is {0.0, 0.0, ...}*/
-        double              belowRatedTorqueGainTableY 	[IKLUTBL_MAXPOINTS];/**<gains defining the below rated torque gain table, in kNm*s^2/rad^2.
+        double              belowRatedTorqueGainTableY 	[IKFASTLUTBL_MAXPOINTS];/**<gains defining the below rated torque gain table, in kNm*s^2/rad^2.
                                                                                      The default value is {0.0, 0.0, ...}*/
 		int                 minimumPitchTableN;								/**<number of points defining the minimum pitch table.
                                                                                      The default value is 1.*/
-        double              minimumPitchTableX			[IKLUTBL_MAXPOINTS];/**<derating ratios defining the minimum pitch table, non-dimensional.
+        double              minimumPitchTableX			[IKFASTLUTBL_MAXPOINTS];/**<derating ratios defining the minimum pitch table, non-dimensional.
                                                                                      The default value is {0.0, 0.0, ...}*/
-        double              minimumPitchTableY			[IKLUTBL_MAXPOINTS];/**<pitch angles defining the minimum pitch table, in degrees.
+        double              minimumPitchTableY			[IKFASTLUTBL_MAXPOINTS];/**<pitch angles defining the minimum pitch table, in degrees.
                                                                                      The default value is {0.0, 0.0, ...}*/
     } ikPowmanParams;
     
     /**
-     * Initialise an instance
-     * @param self instance
+     * Initialise a tuning instance. This must not be done while power managers use it.
+     * @param self tuning instance
      * @param params initialisation parameters
      * @return error code:
      * @li 0: no error
 	 * @li -1: invalid efficiency value, must be non-zero
 	 * @li -2: invalid below rated speed-torque curve gain look-up table initialisation parameters
 	 * @li -3: invalid minimum pitch look-up table initialisation parameters
+	 * @li -4: too many points in the merged derating look-up table, the derating ratios of both tables together must be at most IKFASTLUTBL_MAXPOINTS
+	 * @li -5: not enough memory for the derating look-up table
      */
-    int ikPowman_init(ikPowman *self, const ikPowmanParams *params);
+    int ikPowmanTuning_init(ikPowmanTuning *self, const ikPowmanParams *params);
+    
+    /**
+     * Free the derating table of a tuning instance, once no power manager uses it,
+     * i.e. once the last @link ikPowman_release @endlink has returned 0. Not needed
+     * if @link ikPowmanTuning_init @endlink failed.
+     * @param self tuning instance
+     */
+    void ikPowmanTuning_release(ikPowmanTuning *self);
+    
+    /**
+     * Get the number of power managers using a tuning instance
+     * @param self tuning instance
+     * @return number of power managers initialised with it and not released
+     */
+    int ikPowmanTuning_getUsers(const ikPowmanTuning *self);
+    
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param tuning tuning, which must outlive the instance or its release
+     */
+    void ikPowman_init(ikPowman *self, ikPowmanTuning *tuning);
+    
+    /**
+     * Stop using the tuning. Power managers on different threads may share a tuning,
+     * as the number of users is kept atomically.
+     * @param self instance
+     * @return number of power managers still using the tuning
+     */
+    int ikPowman_release(ikPowman *self);
     
     /**
      * Initialise initialisation parameter structure
@@ -141,6 +213,15 @@ extern "C" {
      */
     int ikPowman_getOutput(const ikPowman *self, double *output, const char *name);
 
+    /**
+     * Evaluate the minimum pitch for a derating ratio, as @link ikPowman_step @endlink
+     * would, but leaving the instance, its cache and its statistics untouched
+     * @param self power manager instance
+     * @param deratingRatio derating ratio, non-dimensional
+     * @return minimum pitch, in degrees
+     */
+    double ikPowman_evalMinimumPitch(const ikPowman *self, double deratingRatio);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,171 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikRainflow.c
+ * 
+ * @brief Class ikRainflow implementation
+ */
+
+/* @cond */
+
+#include <string.h>
+#include <math.h>
+
+#include "ikRainflow.h"
+
+static int ikRainflow_bin(const ikRainflow *self, double range) {
+	int bin = (int) (range/self->binWidth);
+	return bin < self->nBins ? bin : self->nBins - 1;
+}
+
+/* count n cycles of a given range */
+static void ikRainflow_count(ikRainflow *self, double range, double n) {
+	int i;
+	
+	self->counts[ikRainflow_bin(self, range)] += n;
+	for (i = 0; i < self->nExponents; i++) {
+		self->damage[i] += n*pow(range, self->exponents[i]);
+	}
+}
+
+/* push a turning point and count the cycles it closes */
+static void ikRainflow_push(ikRainflow *self, double x) {
+	double *s;
+	double inner;
+	int n;
+	
+	/* make room, counting the oldest range as a half cycle */
+	if (IKRAINFLOW_MAXRESIDUE <= self->nResidue) {
+		ikRainflow_count(self, fabs(self->residue[1] - self->residue[0]), 0.5);
+		memmove(self->residue, self->residue + 1, (IKRAINFLOW_MAXRESIDUE - 1)*sizeof(double));
+		self->nResidue--;
+	}
+	self->residue[self->nResidue++] = x;
+	
+	/* four-point method */
+	s = self->residue;
+	n = self->nResidue;
+	while (4 <= n) {
+		inner = fabs(s[n-2] - s[n-3]);
+		if (inner > fabs(s[n-3] - s[n-4]) || inner > fabs(s[n-1] - s[n-2])) break;
+		ikRainflow_count(self, inner, 1.0);
+		s[n-3] = s[n-1];
+		n -= 2;
+	}
+	self->nResidue = n;
+}
+
+int ikRainflow_init(ikRainflow *self, const ikRainflowParams *params) {
+	int i;
+	
+	/* check the parameters */
+	if (1 > params->nBins || IKRAINFLOW_MAXBINS < params->nBins) return -1;
+	if (0.0 >= params->maxRange) return -2;
+	if (1 > params->nExponents || IKRAINFLOW_MAXEXPONENTS < params->nExponents) return -3;
+	for (i = 0; i < params->nExponents; i++) {
+		if (0.0 >= params->exponents[i]) return -4;
+	}
+	if (0.0 > params->gate) return -5;
+	
+	/* register the parameters */
+	self->nBins = params->nBins;
+	self->binWidth = params->maxRange/params->nBins;
+	self->nExponents = params->nExponents;
+	for (i = 0; i < self->nExponents; i++) {
+		self->exponents[i] = params->exponents[i];
+		self->damage[i] = 0.0;
+	}
+	self->gate = params->gate;
+	
+	/* nothing counted yet */
+	for (i = 0; i < self->nBins; i++) {
+		self->counts[i] = 0.0;
+	}
+	self->started = 0;
+	self->direction = 0;
+	self->extreme = 0.0;
+	self->nResidue = 0;
+	
+	return 0;
+}
+
+void ikRainflow_initParams(ikRainflowParams *params) {
+	params->nBins = 32;
+	params->maxRange = 1.0;
+	params->nExponents = 1;
+	params->exponents[0] = 4.0;
+	params->gate = 0.0;
+}
+
+void ikRainflow_step(ikRainflow *self, double x) {
+	/* the first sample is the first turning point */
+	if (!self->started) {
+		self->started = 1;
+		self->extreme = x;
+		ikRainflow_push(self, x);
+		return;
+	}
+	
+	/* follow the extreme, and push it when the signal turns back past the gate */
+	if (0 <= self->direction && x > self->extreme) {
+		self->direction = 1;
+		self->extreme = x;
+	} else if (0 >= self->direction && x < self->extreme) {
+		self->direction = -1;
+		self->extreme = x;
+	} else if (fabs(x - self->extreme) > self->gate) {
+		ikRainflow_push(self, self->extreme);
+		self->direction = -self->direction;
+		self->extreme = x;
+	}
+}
+
+double ikRainflow_getDel(const ikRainflow *self, int i, double nEquivalent) {
+	double damage;
+	int j;
+	
+	if (0 > i || self->nExponents <= i || 0.0 >= nEquivalent) return 0.0;
+	
+	/* the residue, up to the current extreme, counts as half cycles */
+	damage = self->damage[i];
+	for (j = 1; j < self->nResidue; j++) {
+		damage += 0.5*pow(fabs(self->residue[j] - self->residue[j-1]), self->exponents[i]);
+	}
+	if (0 != self->direction) damage += 0.5*pow(fabs(self->extreme - self->residue[self->nResidue - 1]), self->exponents[i]);
+	
+	return pow(damage/nEquivalent, 1.0/self->exponents[i]);
+}
+
+double ikRainflow_getHistogram(const ikRainflow *self, double *counts) {
+	int j;
+	
+	for (j = 0; j < self->nBins; j++) {
+		counts[j] = self->counts[j];
+	}
+	
+	/* the residue, up to the current extreme, counts as half cycles */
+	for (j = 1; j < self->nResidue; j++) {
+		counts[ikRainflow_bin(self, fabs(self->residue[j] - self->residue[j-1]))] += 0.5;
+	}
+	if (0 != self->direction) counts[ikRainflow_bin(self, fabs(self->extreme - self->residue[self->nResidue - 1]))] += 0.5;
+	
+	return self->binWidth;
+}
+
+/* @endcond */
@@ -0,0 +1,155 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikRainflow.h
+ * 
+ * @brief Class ikRainflow interface
+ */
+
+#ifndef IKRAINFLOW_H
+#define IKRAINFLOW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IKRAINFLOW_MAXRESIDUE 64
+#define IKRAINFLOW_MAXBINS 64
+#define IKRAINFLOW_MAXEXPONENTS 4
+
+    /**
+     * @struct ikRainflow
+     * @brief Streaming rainflow counter
+     * 
+     * This counts the load cycles of a signal as it goes, by the four-point rainflow
+     * method, and keeps a histogram of the cycle ranges and the damage sums needed for
+     * the damage-equivalent loads for a number of Wöhler exponents.
+     * 
+     * Each sample is compared with the current extreme, and, when the signal turns back
+     * by more than a gate, the extreme is pushed on the residue stack as a turning point.
+     * Whenever the inner range of the last four turning points is not larger than
+     * either outer range, it is counted as a full cycle and its two points are removed.
+     * Each turning point is pushed and removed once, so the work is constant per sample
+     * on average. Should the residue stack fill up, its oldest range is counted as a half
+     * cycle to make room.
+     * 
+     * The residue is counted as half cycles when the results are requested, without
+     * altering the count, so that results can be got at any time.
+     * 
+     * The damage-equivalent load for Wöhler exponent m over N equivalent cycles is
+     * @f[
+     *  L_\mathrm{eq} = \left( \frac{\sum_i n_i S_i^m}{N} \right)^{1/m}
+     * @f]
+     * where n_i is the number of cycles, 1 or 0.5, of range S_i.
+     * 
+     * @par Inputs
+     * @li signal: specify via @link ikRainflow_step @endlink
+     * 
+     * @par Outputs
+     * @li damage-equivalent loads, get via @link ikRainflow_getDel @endlink
+     * @li range histogram, get via @link ikRainflow_getHistogram @endlink
+     * 
+     * @par Methods
+     * @li @link ikRainflow_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikRainflow_init @endlink initialise an instance
+     * @li @link ikRainflow_step @endlink execute periodic calculations
+     * @li @link ikRainflow_getDel @endlink get a damage-equivalent load
+     * @li @link ikRainflow_getHistogram @endlink get the range histogram
+     */
+    typedef struct ikRainflow {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int nBins;
+        double binWidth;
+        int nExponents;
+        double exponents[IKRAINFLOW_MAXEXPONENTS];
+        double gate;
+        int started;
+        int direction;
+        double extreme;
+        int nResidue;
+        double residue[IKRAINFLOW_MAXRESIDUE];
+        double counts[IKRAINFLOW_MAXBINS];
+        double damage[IKRAINFLOW_MAXEXPONENTS];
+        /* @endcond */
+    } ikRainflow;
+
+    /**
+     * @struct ikRainflowParams
+     * @brief Streaming rainflow counter initialisation parameters
+     */
+    typedef struct ikRainflowParams {
+        int nBins; /**<number of histogram bins, evenly spread from 0 to the maximum range. The default value is 32.*/
+        double maxRange; /**<largest cycle range in the histogram, larger ones are counted in the last bin. The default value is 1.0.*/
+        int nExponents; /**<number of Wöhler exponents. The default value is 1.*/
+        double exponents[IKRAINFLOW_MAXEXPONENTS]; /**<Wöhler exponents. The default value is 4.0.*/
+        double gate; /**<smallest turn of the signal recognised as a turning point. The default value is 0.0.*/
+    } ikRainflowParams;
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of bins, must be between 1 and IKRAINFLOW_MAXBINS
+     * @li -2: invalid maximum range, must be positive
+     * @li -3: invalid number of Wöhler exponents, must be between 1 and IKRAINFLOW_MAXEXPONENTS
+     * @li -4: invalid Wöhler exponent, must be positive
+     * @li -5: invalid gate, must be non-negative
+     */
+    int ikRainflow_init(ikRainflow *self, const ikRainflowParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikRainflow_initParams(ikRainflowParams *params);
+
+    /**
+     * Execute periodic calculations
+     * @param self instance
+     * @param x signal
+     */
+    void ikRainflow_step(ikRainflow *self, double x);
+
+    /**
+     * Get a damage-equivalent load, counting the residue as half cycles
+     * @param self instance
+     * @param i Wöhler exponent index
+     * @param nEquivalent number of equivalent cycles, e.g. the duration in s for 1 Hz equivalent loads
+     * @return damage-equivalent load, or 0 if the index or the number of equivalent cycles is invalid
+     */
+    double ikRainflow_getDel(const ikRainflow *self, int i, double nEquivalent);
+
+    /**
+     * Get the range histogram, counting the residue as half cycles
+     * @param self instance
+     * @param counts number of cycles in each bin, as many as bins
+     * @return bin width
+     */
+    double ikRainflow_getHistogram(const ikRainflow *self, double *counts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKRAINFLOW_H */
@@ -0,0 +1,234 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikSharedMemory.c
+ * 
+ * @brief Class ikSharedMemory implementation
+ */
+
+/* @cond */
+
+#ifndef _WIN32
+/* shm_open, ftruncate, nanosleep, kill */
+#define _POSIX_C_SOURCE 200112L
+/* syscall */
+#define _DEFAULT_SOURCE
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <time.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+#include "ikSharedMemory.h"
+
+static int ikSharedMemory_setName(ikSharedMemory *self, const char *name) {
+#ifdef _WIN32
+	if (IKSHAREDMEMORY_MAXNAME <= strlen(name)) return -1;
+	strcpy(self->name, name);
+#else
+	/* POSIX shared memory names start with a slash */
+	if (IKSHAREDMEMORY_MAXNAME - 1 <= strlen(name)) return -1;
+	self->name[0] = '/';
+	strcpy(self->name + ('/' != name[0]), name);
+#endif
+	return 0;
+}
+
+static int ikSharedMemory_map(ikSharedMemory *self, unsigned long size) {
+#ifdef _WIN32
+	HANDLE h;
+	MEMORY_BASIC_INFORMATION info;
+	
+	if (self->owner) h = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD) size, self->name);
+	else h = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, self->name);
+	if (NULL == h) return -2;
+	/* never share a region with another creator */
+	if (self->owner && ERROR_ALREADY_EXISTS == GetLastError()) {
+		CloseHandle(h);
+		return -3;
+	}
+	/* map the whole region, whatever its size */
+	self->address = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+	if (NULL == self->address) {
+		CloseHandle(h);
+		return -2;
+	}
+	if (!self->owner) {
+		VirtualQuery(self->address, &info, sizeof(info));
+		size = (unsigned long) info.RegionSize;
+	}
+	self->handle = h;
+#else
+	struct stat st;
+	void *p;
+	
+	/* never share a region with another creator */
+	if (self->owner) self->fd = shm_open(self->name, O_RDWR | O_CREAT | O_EXCL, 0666);
+	else self->fd = shm_open(self->name, O_RDWR, 0666);
+	if (0 > self->fd) return self->owner && EEXIST == errno ? -3 : -2;
+	if (self->owner) {
+		if (ftruncate(self->fd, (off_t) size)) {
+			close(self->fd);
+			shm_unlink(self->name);
+			return -2;
+		}
+	} else {
+		if (fstat(self->fd, &st) || 0 >= st.st_size) {
+			close(self->fd);
+			return -2;
+		}
+		size = (unsigned long) st.st_size;
+	}
+	p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, self->fd, 0);
+	if (MAP_FAILED == p) {
+		close(self->fd);
+		if (self->owner) shm_unlink(self->name);
+		return -2;
+	}
+	self->address = p;
+#endif
+	self->size = size;
+	return 0;
+}
+
+/* @endcond */
+
+int ikSharedMemory_create(ikSharedMemory *self, const char *name, unsigned long size) {
+	self->address = NULL;
+	self->size = 0;
+	self->handle = NULL;
+	self->fd = -1;
+	self->owner = 1;
+	if (ikSharedMemory_setName(self, name)) return -1;
+	return ikSharedMemory_map(self, size);
+}
+
+int ikSharedMemory_open(ikSharedMemory *self, const char *name) {
+	self->address = NULL;
+	self->size = 0;
+	self->handle = NULL;
+	self->fd = -1;
+	self->owner = 0;
+	if (ikSharedMemory_setName(self, name)) return -1;
+	return ikSharedMemory_map(self, 0);
+}
+
+void ikSharedMemory_close(ikSharedMemory *self) {
+	if (NULL == self->address) return;
+#ifdef _WIN32
+	UnmapViewOfFile(self->address);
+	CloseHandle((HANDLE) self->handle);
+#else
+	munmap(self->address, self->size);
+	close(self->fd);
+	if (self->owner) shm_unlink(self->name);
+#endif
+	self->address = NULL;
+}
+
+void ikSharedMemory_barrier(void) {
+#ifdef _WIN32
+	MemoryBarrier();
+#else
+	__sync_synchronize();
+#endif
+}
+
+unsigned int ikSharedMemory_increment(volatile unsigned int *word) {
+#ifdef _WIN32
+	return (unsigned int) InterlockedIncrement((volatile LONG *) word);
+#else
+	return __sync_add_and_fetch(word, 1u);
+#endif
+}
+
+int ikSharedMemory_compareAndSwap(volatile unsigned int *word, unsigned int value, unsigned int newValue) {
+#ifdef _WIN32
+	return value == (unsigned int) InterlockedCompareExchange((volatile LONG *) word, (LONG) newValue, (LONG) value);
+#else
+	return __sync_bool_compare_and_swap(word, value, newValue);
+#endif
+}
+
+void ikSharedMemory_wait(volatile unsigned int *word, unsigned int value, int timeout) {
+#if defined(_WIN32)
+	(void) timeout;
+	if (*word == value) SwitchToThread();
+#elif defined(__linux__)
+	struct timespec t;
+	
+	t.tv_sec = timeout/1000;
+	t.tv_nsec = (timeout%1000)*1000000L;
+	/* process-shared futex, i.e. without FUTEX_PRIVATE_FLAG */
+	syscall(SYS_futex, (unsigned int *) word, FUTEX_WAIT, value, &t, NULL, 0);
+#else
+	(void) timeout;
+	if (*word == value) sched_yield();
+#endif
+}
+
+void ikSharedMemory_wake(volatile unsigned int *word) {
+#if defined(__linux__)
+	syscall(SYS_futex, (unsigned int *) word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#else
+	(void) word;
+#endif
+}
+
+unsigned int ikSharedMemory_getProcess(void) {
+#ifdef _WIN32
+	return (unsigned int) GetCurrentProcessId();
+#else
+	return (unsigned int) getpid();
+#endif
+}
+
+int ikSharedMemory_isProcessAlive(unsigned int process) {
+#ifdef _WIN32
+	HANDLE h;
+	int alive;
+	
+	h = OpenProcess(SYNCHRONIZE, FALSE, (DWORD) process);
+	/* a process which cannot be opened for lack of rights exists */
+	if (NULL == h) return ERROR_ACCESS_DENIED == GetLastError();
+	alive = WAIT_TIMEOUT == WaitForSingleObject(h, 0);
+	CloseHandle(h);
+	return alive;
+#else
+	/* a process which cannot be signalled for lack of rights exists */
+	return 0 == kill((pid_t) process, 0) || EPERM == errno;
+#endif
+}
@@ -0,0 +1,153 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikSharedMemory.h
+ * 
+ * @brief Class ikSharedMemory interface
+ */
+
+#ifndef IKSHAREDMEMORY_H
+#define IKSHAREDMEMORY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IKSHAREDMEMORY_MAXNAME 256
+
+    /**
+     * @struct ikSharedMemory
+     * @brief Named shared memory region
+     * 
+     * This is a thin portable layer over POSIX shared memory objects and Windows
+     * file mappings, together with the memory barrier and the wait and wake
+     * operations needed to exchange data through them between processes.
+     * 
+     * @par Methods
+     * @li @link ikSharedMemory_create @endlink create a region
+     * @li @link ikSharedMemory_open @endlink open an existing region
+     * @li @link ikSharedMemory_close @endlink close a region, and remove it if created by this instance
+     * @li @link ikSharedMemory_barrier @endlink full memory barrier
+     * @li @link ikSharedMemory_increment @endlink atomically increment a word in shared memory
+     * @li @link ikSharedMemory_compareAndSwap @endlink atomically replace a word in shared memory if it has a given value
+     * @li @link ikSharedMemory_wait @endlink wait for a word in shared memory to change
+     * @li @link ikSharedMemory_wake @endlink wake those waiting for a word in shared memory to change
+     * @li @link ikSharedMemory_getProcess @endlink get the identifier of the calling process
+     * @li @link ikSharedMemory_isProcessAlive @endlink check whether a process is still running
+     */
+    typedef struct ikSharedMemory {
+        void *address; /**<start of the region, NULL if closed*/
+        unsigned long size; /**<size of the region in bytes*/
+        /**
+         * Private members
+         */
+        /* @cond */
+        void *handle;
+        int fd;
+        int owner;
+        char name[IKSHAREDMEMORY_MAXNAME];
+        /* @endcond */
+    } ikSharedMemory;
+
+    /**
+     * Create a region, filled with zeros
+     * @param self instance
+     * @param name region name
+     * @param size region size in bytes
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid name, too long
+     * @li -2: the region cannot be created
+     * @li -3: a region with this name already exists, e.g. created by another process or left behind by one which crashed
+     */
+    int ikSharedMemory_create(ikSharedMemory *self, const char *name, unsigned long size);
+
+    /**
+     * Open an existing region
+     * @param self instance
+     * @param name region name
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid name, too long
+     * @li -2: the region cannot be opened
+     */
+    int ikSharedMemory_open(ikSharedMemory *self, const char *name);
+
+    /**
+     * Close a region, and remove it if this instance created it
+     * @param self instance
+     */
+    void ikSharedMemory_close(ikSharedMemory *self);
+
+    /**
+     * Full memory barrier
+     */
+    void ikSharedMemory_barrier(void);
+
+    /**
+     * Atomically increment a word in shared memory
+     * @param word word in shared memory
+     * @return the incremented value
+     */
+    unsigned int ikSharedMemory_increment(volatile unsigned int *word);
+
+    /**
+     * Atomically replace a word in shared memory if it has a given value
+     * @param word word in shared memory
+     * @param value expected value
+     * @param newValue replacement value
+     * @return 1 if replaced, 0 otherwise
+     */
+    int ikSharedMemory_compareAndSwap(volatile unsigned int *word, unsigned int value, unsigned int newValue);
+
+    /**
+     * Wait for a word in shared memory to change, or for a timeout.
+     * Where the operating system offers no such wait, this just yields the processor,
+     * so it must be called in a loop which checks the word.
+     * @param word word in shared memory
+     * @param value value of the word to wait for a change of
+     * @param timeout timeout in ms
+     */
+    void ikSharedMemory_wait(volatile unsigned int *word, unsigned int value, int timeout);
+
+    /**
+     * Wake those waiting for a word in shared memory to change
+     * @param word word in shared memory
+     */
+    void ikSharedMemory_wake(volatile unsigned int *word);
+
+    /**
+     * Get the identifier of the calling process, never 0
+     * @return process identifier
+     */
+    unsigned int ikSharedMemory_getProcess(void);
+
+    /**
+     * Check whether a process is still running, e.g. to reclaim what a crashed one
+     * has left behind in shared memory. A recycled identifier counts as running.
+     * @param process process identifier
+     * @return 1 if running, 0 otherwise
+     */
+    int ikSharedMemory_isProcessAlive(unsigned int process);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKSHAREDMEMORY_H */
@@ -60,6 +60,11 @@ void ikSpdman_initParams(ikSpdmanParams *params) {
 	params->maxAzimuth = 360.0;
 }
 
+void ikSpdman_warmStart(ikSpdman *self, double rotorSpeed, double azimuth) {
+	/* pretend the previous step was at the same speed */
+	self->lastAzimuth = azimuth - rotorSpeed*self->T*180.0/3.14159265358979;
+}
+
 int ikSpdman_step(ikSpdman *self, double generatorSpeed, double rotorSpeed, double azimuth) {
     int i;
 	double diff;
@@ -105,6 +110,10 @@ int ikSpdman_getOutput(const ikSpdman *self, double *output, const char *name) {
         *output = self->outputSpeed;
         return 0;
     }
+    if (!strcmp(name, "status")) {
+        *output = self->status;
+        return 0;
+    }
     if (!strcmp(name, "signal 1")) {
         *output = self->signals[0];
         return 0;
@@ -72,6 +72,7 @@ extern "C" {
      * @par Methods
      * @li @link ikSpdman_initParams @endlink initialise initialisation parameter structure
      * @li @link ikSpdman_init @endlink initialise an instance
+     * @li @link ikSpdman_warmStart @endlink set the initial state from the operating point
      * @li @link ikSpdman_step @endlink execute periodic calculations
      * @li @link ikSpdman_getOutput @endlink get output value
      */
@@ -122,6 +123,15 @@ extern "C" {
      */
     void ikSpdman_initParams(ikSpdmanParams *params);
     
+    /**
+     * Set the initial state from the operating point, so that the azimuth
+     * derivative is right from the first step
+     * @param self instance
+     * @param rotorSpeed rotor speed, in rad/s
+     * @param azimuth rotor azimuth angle at the first step, in degrees
+     */
+    void ikSpdman_warmStart(ikSpdman *self, double rotorSpeed, double azimuth);
+    
     /**
 	 * Execute periodic calculations
 	 * @param self instance
@@ -0,0 +1,78 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikStats.c
+ * 
+ * @brief Class ikStats implementation
+ */
+
+/* @cond */
+
+#include <math.h>
+
+#include "ikStats.h"
+
+void ikStats_init(ikStats *self) {
+	self->n = 0;
+	self->mean = 0.0;
+	self->m2 = 0.0;
+	self->min = 0.0;
+	self->max = 0.0;
+}
+
+void ikStats_step(ikStats *self, double x) {
+	double delta;
+	
+	if (0 == self->n) {
+		self->min = x;
+		self->max = x;
+	} else {
+		if (x < self->min) self->min = x;
+		if (x > self->max) self->max = x;
+	}
+	
+	/* Welford's update */
+	self->n++;
+	delta = x - self->mean;
+	self->mean += delta/self->n;
+	self->m2 += delta*(x - self->mean);
+}
+
+unsigned long ikStats_getCount(const ikStats *self) {
+	return self->n;
+}
+
+double ikStats_getMean(const ikStats *self) {
+	return self->mean;
+}
+
+double ikStats_getStd(const ikStats *self) {
+	if (0 == self->n) return 0.0;
+	return sqrt(self->m2/self->n);
+}
+
+double ikStats_getMin(const ikStats *self) {
+	return self->min;
+}
+
+double ikStats_getMax(const ikStats *self) {
+	return self->max;
+}
+
+/* @endcond */
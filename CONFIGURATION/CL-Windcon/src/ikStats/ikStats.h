@@ -0,0 +1,129 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikStats.h
+ * 
+ * @brief Class ikStats interface
+ */
+
+#ifndef IKSTATS_H
+#define IKSTATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @struct ikStats
+     * @brief Single-pass statistics
+     * 
+     * This accumulates the mean, standard deviation, minimum and maximum of a signal,
+     * sample by sample, with Welford's update, which does not lose precision to large
+     * sums of squares however long the signal is:
+     * @f[
+     *  \bar{x}_n = \bar{x}_{n-1} + \frac{x_n - \bar{x}_{n-1}}{n} \qquad
+     *  M_n = M_{n-1} + (x_n - \bar{x}_{n-1})(x_n - \bar{x}_n)
+     * @f]
+     * with the standard deviation being @f$\sqrt{M_n/n}@f$.
+     * 
+     * @par Inputs
+     * @li signal: specify via @link ikStats_step @endlink
+     * 
+     * @par Outputs
+     * @li number of samples, get via @link ikStats_getCount @endlink
+     * @li mean, get via @link ikStats_getMean @endlink
+     * @li standard deviation, get via @link ikStats_getStd @endlink
+     * @li minimum, get via @link ikStats_getMin @endlink
+     * @li maximum, get via @link ikStats_getMax @endlink
+     * 
+     * @par Methods
+     * @li @link ikStats_init @endlink initialise an instance, with no samples
+     * @li @link ikStats_step @endlink add a sample
+     * @li @link ikStats_getCount @endlink get the number of samples
+     * @li @link ikStats_getMean @endlink get the mean
+     * @li @link ikStats_getStd @endlink get the standard deviation
+     * @li @link ikStats_getMin @endlink get the minimum
+     * @li @link ikStats_getMax @endlink get the maximum
+     */
+    typedef struct ikStats {
+        /**
+         * Private members
+         */
+        /* @cond */
+        unsigned long n;
+        double mean;
+        double m2;
+        double min;
+        double max;
+        /* @endcond */
+    } ikStats;
+
+    /**
+     * Initialise an instance, with no samples
+     * @param self instance
+     */
+    void ikStats_init(ikStats *self);
+
+    /**
+     * Add a sample
+     * @param self instance
+     * @param x signal
+     */
+    void ikStats_step(ikStats *self, double x);
+
+    /**
+     * Get the number of samples
+     * @param self instance
+     * @return number of samples
+     */
+    unsigned long ikStats_getCount(const ikStats *self);
+
+    /**
+     * Get the mean
+     * @param self instance
+     * @return mean, or 0 with no samples
+     */
+    double ikStats_getMean(const ikStats *self);
+
+    /**
+     * Get the (population) standard deviation
+     * @param self instance
+     * @return standard deviation, or 0 with no samples
+     */
+    double ikStats_getStd(const ikStats *self);
+
+    /**
+     * Get the minimum
+     * @param self instance
+     * @return minimum, or 0 with no samples
+     */
+    double ikStats_getMin(const ikStats *self);
+
+    /**
+     * Get the maximum
+     * @param self instance
+     * @return maximum, or 0 with no samples
+     */
+    double ikStats_getMax(const ikStats *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKSTATS_H */
@@ -0,0 +1,174 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikSuperconChannel.c
+ * 
+ * @brief Class ikSuperconChannel implementation
+ */
+
+/* @cond */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ikSuperconChannel.h"
+
+#define IKSUPERCONCHANNEL_MAGIC 0x43534b49u /* "IKSC" */
+#define IKSUPERCONCHANNEL_VERSION 1u
+#define IKSUPERCONCHANNEL_CACHELINE 64
+
+/* shared memory layout: a header followed by one slot per turbine,
+   each a cache line long, so that turbines do not share cache lines */
+typedef struct ikSuperconChannelHeader {
+	unsigned int magic;
+	unsigned int version;
+	unsigned int nTurbines;
+	char pad[IKSUPERCONCHANNEL_CACHELINE - 3*sizeof(unsigned int)];
+} ikSuperconChannelHeader;
+
+typedef struct ikSuperconChannelSlot {
+	volatile unsigned int sequence;
+	unsigned int pad;
+	ikSuperconMessage message;
+	char pad2[IKSUPERCONCHANNEL_CACHELINE - 2*sizeof(unsigned int) - sizeof(ikSuperconMessage)];
+} ikSuperconChannelSlot;
+
+/* number of attempts at a consistent copy before giving up until the next read */
+#define IKSUPERCONCHANNEL_TRIES 8
+
+static ikSuperconChannelSlot *ikSuperconChannel_slot(const ikSuperconChannel *self, int turbine) {
+	return (ikSuperconChannelSlot *) ((char *) self->memory.address + sizeof(ikSuperconChannelHeader)) + turbine;
+}
+
+/* @endcond */
+
+int ikSuperconChannel_init(ikSuperconChannel *self, const ikSuperconChannelParams *params) {
+	ikSuperconChannelHeader *header;
+	int i;
+	int err;
+	
+	self->memory.address = NULL;
+	
+	/* register parameter values */
+	if (IKSHAREDMEMORY_MAXNAME - 1 <= strlen(params->name)) return -1;
+	self->create = params->create;
+	self->maxAge = params->maxAge;
+	self->turbine = params->turbine;
+	self->lastSequence = 0;
+	self->age = 0;
+	
+	if (self->create) {
+		/* create and initialise the shared memory */
+		if (0 >= params->nTurbines) return -2;
+		self->nTurbines = params->nTurbines;
+		err = ikSharedMemory_create(&(self->memory), params->name, sizeof(ikSuperconChannelHeader) + params->nTurbines*sizeof(ikSuperconChannelSlot));
+		if (err) return -3;
+		header = (ikSuperconChannelHeader *) self->memory.address;
+		for (i = 0; i < self->nTurbines; i++) {
+			ikSuperconChannel_slot(self, i)->sequence = 0;
+		}
+		header->nTurbines = (unsigned int) self->nTurbines;
+		header->version = IKSUPERCONCHANNEL_VERSION;
+		ikSharedMemory_barrier();
+		header->magic = IKSUPERCONCHANNEL_MAGIC;
+	} else {
+		/* open the shared memory and check it */
+		err = ikSharedMemory_open(&(self->memory), params->name);
+		if (err) return -3;
+		header = (ikSuperconChannelHeader *) self->memory.address;
+		if (self->memory.size < sizeof(ikSuperconChannelHeader) || IKSUPERCONCHANNEL_MAGIC != header->magic || IKSUPERCONCHANNEL_VERSION != header->version) {
+			ikSuperconChannel_close(self);
+			return -4;
+		}
+		self->nTurbines = (int) header->nTurbines;
+		if (self->memory.size < sizeof(ikSuperconChannelHeader) + self->nTurbines*sizeof(ikSuperconChannelSlot)) {
+			ikSuperconChannel_close(self);
+			return -4;
+		}
+		if (0 > self->turbine || self->nTurbines <= self->turbine) {
+			ikSuperconChannel_close(self);
+			return -5;
+		}
+	}
+	
+	return 0;
+}
+
+void ikSuperconChannel_initParams(ikSuperconChannelParams *params) {
+	params->name = "OpenDisconSupercon";
+	params->create = 0;
+	params->nTurbines = 1;
+	params->turbine = 0;
+	params->maxAge = 1000;
+}
+
+int ikSuperconChannel_read(ikSuperconChannel *self, ikSuperconMessage *message) {
+	ikSuperconChannelSlot *slot;
+	ikSuperconMessage copy;
+	unsigned int s1;
+	unsigned int s2;
+	int i;
+	
+	if (NULL == self->memory.address) return -1;
+	slot = ikSuperconChannel_slot(self, self->turbine);
+	
+	/* try to get a consistent copy of the message */
+	for (i = 0; i < IKSUPERCONCHANNEL_TRIES; i++) {
+		s1 = slot->sequence;
+		if (s1 & 1u) continue;
+		ikSharedMemory_barrier();
+		copy = slot->message;
+		ikSharedMemory_barrier();
+		s2 = slot->sequence;
+		if (s1 == s2) break;
+	}
+	
+	/* a new message */
+	if (i < IKSUPERCONCHANNEL_TRIES && 0 != s1 && s1 != self->lastSequence) {
+		*message = copy;
+		self->lastSequence = s1;
+		self->age = 0;
+		return 0;
+	}
+	
+	/* no new message, possibly because the supercontroller was busy writing */
+	if (self->age < self->maxAge) self->age++;
+	if (0 == self->lastSequence || self->age >= self->maxAge) return -1;
+	return 1;
+}
+
+int ikSuperconChannel_publish(ikSuperconChannel *self, int turbine, const ikSuperconMessage *message) {
+	ikSuperconChannelSlot *slot;
+	
+	if (NULL == self->memory.address || 0 > turbine || self->nTurbines <= turbine) return -1;
+	slot = ikSuperconChannel_slot(self, turbine);
+	
+	/* odd sequence number while writing */
+	slot->sequence++;
+	ikSharedMemory_barrier();
+	slot->message = *message;
+	ikSharedMemory_barrier();
+	slot->sequence++;
+	
+	return 0;
+}
+
+void ikSuperconChannel_close(ikSuperconChannel *self) {
+	ikSharedMemory_close(&(self->memory));
+}
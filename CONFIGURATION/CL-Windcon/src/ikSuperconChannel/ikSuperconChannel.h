@@ -0,0 +1,149 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikSuperconChannel.h
+ * 
+ * @brief Class ikSuperconChannel interface
+ */
+
+#ifndef IKSUPERCONCHANNEL_H
+#define IKSUPERCONCHANNEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ikSharedMemory.h"
+
+    /**
+     * @struct ikSuperconMessage
+     * @brief Wind farm level inputs to a turbine controller
+     */
+    typedef struct ikSuperconMessage {
+        double deratingRatio; /**<derating ratio, non-dimensional*/
+        double externalMaximumTorque; /**<external maximum torque in kNm*/
+        double externalMinimumTorque; /**<external minimum torque in kNm*/
+        double externalMaximumPitch; /**<external maximum pitch in degrees*/
+        double externalMinimumPitch; /**<external minimum pitch in degrees*/
+        double yawErrorReference; /**<yaw error reference in degrees*/
+    } ikSuperconMessage;
+
+    /**
+     * @struct ikSuperconChannel
+     * @brief Shared memory supercontroller channel
+     * 
+     * This is a named shared memory region through which a supercontroller process
+     * publishes an @link ikSuperconMessage @endlink for each turbine of a wind farm,
+     * and the turbine controllers read their own.
+     * 
+     * Each turbine has its own slot, one cache line long, guarded by a sequence lock:
+     * the supercontroller makes the sequence number odd while it writes, and even
+     * again when done, and the controllers copy the message and retry if the sequence
+     * number was odd or has changed meanwhile. Neither side ever waits for the other.
+     * 
+     * A controller considers the channel stale if the sequence number of its slot has
+     * not changed for a given number of reads, or if nothing has ever been published.
+     * 
+     * @par Methods
+     * @li @link ikSuperconChannel_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikSuperconChannel_init @endlink initialise an instance, i.e. open or create the shared memory
+     * @li @link ikSuperconChannel_read @endlink read the latest message
+     * @li @link ikSuperconChannel_publish @endlink publish a message
+     * @li @link ikSuperconChannel_close @endlink close the shared memory
+     */
+    typedef struct ikSuperconChannel {
+        /**
+         * Private members
+         */
+        /* @cond */
+        ikSharedMemory memory;
+        int create;
+        int nTurbines;
+        int turbine;
+        int maxAge;
+        unsigned int lastSequence;
+        int age;
+        /* @endcond */
+    } ikSuperconChannel;
+
+    /**
+     * @struct ikSuperconChannelParams
+     * @brief Shared memory supercontroller channel initialisation parameters
+     */
+    typedef struct ikSuperconChannelParams {
+        const char *name; /**<shared memory name. The default value is "OpenDisconSupercon".*/
+        int create; /**<whether to create the shared memory, as the supercontroller does, rather than open it, as the controllers do. The default value is 0.*/
+        int nTurbines; /**<number of turbines, only used when creating. The default value is 1.*/
+        int turbine; /**<turbine index, from 0, only used when reading. The default value is 0.*/
+        int maxAge; /**<number of reads without a new message after which the channel is stale. The default value is 1000.*/
+    } ikSuperconChannelParams;
+
+    /**
+     * Initialise an instance, by opening or creating the shared memory
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid name, must be shorter than IKSHAREDMEMORY_MAXNAME - 1 characters
+     * @li -2: invalid number of turbines, must be positive
+     * @li -3: the shared memory cannot be opened or created, e.g. because another supercontroller has created it
+     * @li -4: the shared memory is not a supercontroller channel
+     * @li -5: invalid turbine index, must be between 0 and the number of turbines minus 1
+     */
+    int ikSuperconChannel_init(ikSuperconChannel *self, const ikSuperconChannelParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikSuperconChannel_initParams(ikSuperconChannelParams *params);
+
+    /**
+     * Read the latest message for this turbine, without waiting
+     * @param self instance
+     * @param message latest message, unchanged if the channel is stale
+     * @return state:
+     * @li 0: new message
+     * @li 1: no new message since the last read, but the channel is not stale yet
+     * @li -1: stale channel
+     */
+    int ikSuperconChannel_read(ikSuperconChannel *self, ikSuperconMessage *message);
+
+    /**
+     * Publish a message for a turbine
+     * @param self instance
+     * @param turbine turbine index, from 0
+     * @param message message
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid turbine index
+     */
+    int ikSuperconChannel_publish(ikSuperconChannel *self, int turbine, const ikSuperconMessage *message);
+
+    /**
+     * Close the shared memory, and remove it if this instance created it
+     * @param self instance
+     */
+    void ikSuperconChannel_close(ikSuperconChannel *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKSUPERCONCHANNEL_H */
@@ -0,0 +1,206 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikSuperconStandIn.c
+ *
+ * @brief Stand-in supercontroller
+ *
+ * Creates the shared memory supercontroller channel for a number of turbines,
+ * and publishes a message for each of them periodically, so that the controllers
+ * never find the channel stale. All messages start as the same default message,
+ * and are replaced by those read from the standard input, one per line, as follows:
+ * @code
+ * turbine deratingRatio maxTorque minTorque maxPitch minPitch yawErrorReference
+ * @endcode
+ * with a negative turbine index meaning all turbines. Usage:
+ * @code
+ * ikSuperconStandIn [nTurbines [channelName [period]]]
+ * @endcode
+ * where the publishing period is in ms, 100 by default. Stop it with Ctrl+C.
+ */
+
+#ifndef _WIN32
+/* nanosleep */
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#include <pthread.h>
+#endif
+#include "ikSuperconChannel.h"
+
+/* native threads, as MSVC has no pthreads */
+#ifdef _WIN32
+typedef CRITICAL_SECTION readerLock;
+#define LOCK_INIT(l) InitializeCriticalSection(l)
+#define LOCK(l) EnterCriticalSection(l)
+#define UNLOCK(l) LeaveCriticalSection(l)
+#else
+typedef pthread_mutex_t readerLock;
+#define LOCK_INIT(l) pthread_mutex_init(l, NULL)
+#define LOCK(l) pthread_mutex_lock(l)
+#define UNLOCK(l) pthread_mutex_unlock(l)
+#endif
+
+typedef struct reader {
+	ikSuperconMessage *messages;
+	int nTurbines;
+	readerLock lock;
+} reader;
+
+static volatile sig_atomic_t stop = 0;
+
+static void onSignal(int sig) {
+	(void) sig;
+	stop = 1;
+}
+
+static void sleepFor(int period) {
+#ifdef _WIN32
+	Sleep(period);
+#else
+	struct timespec t;
+	
+	t.tv_sec = period/1000;
+	t.tv_nsec = (period%1000)*1000000L;
+	nanosleep(&t, NULL);
+#endif
+}
+
+static void readInput(reader *r) {
+	ikSuperconMessage message;
+	char line[512];
+	int turbine;
+	int i;
+	
+	/* replace the messages with those from the standard input */
+	while (NULL != fgets(line, sizeof(line), stdin)) {
+		if (7 != sscanf(line, "%d %lf %lf %lf %lf %lf %lf", &turbine,
+				&message.deratingRatio, &message.externalMaximumTorque, &message.externalMinimumTorque,
+				&message.externalMaximumPitch, &message.externalMinimumPitch, &message.yawErrorReference)) {
+			fprintf(stderr, "Ignored: %s", line);
+			continue;
+		}
+		if (r->nTurbines <= turbine) {
+			fprintf(stderr, "Invalid turbine index %d\n", turbine);
+			continue;
+		}
+		LOCK(&(r->lock));
+		if (0 > turbine) {
+			for (i = 0; i < r->nTurbines; i++) r->messages[i] = message;
+		} else {
+			r->messages[turbine] = message;
+		}
+		UNLOCK(&(r->lock));
+	}
+}
+
+#ifdef _WIN32
+static DWORD WINAPI runReader(LPVOID arg) {
+	readInput((reader *) arg);
+	return 0;
+}
+
+static int startReader(reader *r) {
+	HANDLE thread = CreateThread(NULL, 0, runReader, r, 0, NULL);
+	
+	if (NULL == thread) return -1;
+	CloseHandle(thread);
+	return 0;
+}
+#else
+static void *runReader(void *arg) {
+	readInput((reader *) arg);
+	return NULL;
+}
+
+static int startReader(reader *r) {
+	pthread_t thread;
+	
+	if (pthread_create(&thread, NULL, runReader, r)) return -1;
+	pthread_detach(thread);
+	return 0;
+}
+#endif
+
+int main(int argc, char *argv[]) {
+	ikSuperconChannel channel;
+	ikSuperconChannelParams params;
+	ikSuperconMessage message;
+	reader r;
+	int period = 100;
+	int i;
+	int err;
+	
+	/* create the channel */
+	ikSuperconChannel_initParams(&params);
+	params.create = 1;
+	if (1 < argc) params.nTurbines = atoi(argv[1]);
+	if (2 < argc) params.name = argv[2];
+	if (3 < argc) period = atoi(argv[3]);
+	if (0 >= period) period = 100;
+	err = ikSuperconChannel_init(&channel, &params);
+	if (err) {
+		fprintf(stderr, "Cannot create supercontroller channel %s, error %d: another supercontroller may be using it, or a crashed one may have left it behind\n", params.name, err);
+		return 1;
+	}
+	
+	/* start with the default message, the same as ikClwindconSupercon uses */
+	message.deratingRatio = 0.2;
+	message.externalMaximumTorque = 230.0;
+	message.externalMinimumTorque = 0.0;
+	message.externalMaximumPitch = 90.0;
+	message.externalMinimumPitch = 0.0;
+	message.yawErrorReference = 0.0;
+	r.nTurbines = params.nTurbines;
+	r.messages = (ikSuperconMessage *) malloc(r.nTurbines*sizeof(ikSuperconMessage));
+	if (NULL == r.messages) {
+		fprintf(stderr, "Not enough memory for %d turbines\n", r.nTurbines);
+		ikSuperconChannel_close(&channel);
+		return 1;
+	}
+	for (i = 0; i < r.nTurbines; i++) r.messages[i] = message;
+	LOCK_INIT(&(r.lock));
+	
+	signal(SIGINT, onSignal);
+	signal(SIGTERM, onSignal);
+	
+	/* read the standard input meanwhile */
+	if (startReader(&r)) fprintf(stderr, "Cannot read the standard input, publishing the default messages only\n");
+	printf("Supercontroller channel %s created for %d turbines, publishing every %d ms\n", params.name, params.nTurbines, period);
+	fflush(stdout);
+	
+	/* publish all messages periodically, this being the only writer of the channel */
+	while (!stop) {
+		LOCK(&(r.lock));
+		for (i = 0; i < r.nTurbines; i++) ikSuperconChannel_publish(&channel, i, r.messages + i);
+		UNLOCK(&(r.lock));
+		sleepFor(period);
+	}
+	
+	/* the reader may be blocked on the standard input, and goes with the process */
+	ikSuperconChannel_close(&channel);
+	return 0;
+}
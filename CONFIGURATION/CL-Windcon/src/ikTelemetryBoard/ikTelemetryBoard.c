@@ -0,0 +1,165 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikTelemetryBoard.c
+ * 
+ * @brief Class ikTelemetryBoard implementation
+ */
+
+/* @cond */
+
+#include <string.h>
+
+#include "ikTelemetryBoard.h"
+
+#define IKTELEMETRYBOARD_MAGIC 0x42544b49u /* "IKTB" */
+#define IKTELEMETRYBOARD_VERSION 1u
+#define IKTELEMETRYBOARD_CACHELINE 64
+
+/* number of attempts at a consistent copy before giving up until the next read */
+#define IKTELEMETRYBOARD_TRIES 8
+
+/* shared memory layout: a header with the signal names, followed by the
+   snapshot, starting at a cache line boundary, with one value per signal */
+typedef struct ikTelemetryBoardHeader {
+	unsigned int magic;
+	unsigned int version;
+	unsigned int n;
+	unsigned int pad;
+	char names[IKTELEMETRYBOARD_MAXSIGNALS][IKTELEMETRYBOARD_MAXNAME];
+} ikTelemetryBoardHeader;
+
+typedef struct ikTelemetryBoardSnapshot {
+	volatile unsigned int sequence;
+	unsigned int pad;
+	unsigned long step;
+	double values[IKTELEMETRYBOARD_MAXSIGNALS];
+} ikTelemetryBoardSnapshot;
+
+#define IKTELEMETRYBOARD_SNAPSHOT ((sizeof(ikTelemetryBoardHeader) + IKTELEMETRYBOARD_CACHELINE - 1)/IKTELEMETRYBOARD_CACHELINE*IKTELEMETRYBOARD_CACHELINE)
+
+static ikTelemetryBoardHeader *ikTelemetryBoard_header(const ikTelemetryBoard *self) {
+	return (ikTelemetryBoardHeader *) self->memory.address;
+}
+
+static ikTelemetryBoardSnapshot *ikTelemetryBoard_snapshot(const ikTelemetryBoard *self) {
+	return (ikTelemetryBoardSnapshot *) ((char *) self->memory.address + IKTELEMETRYBOARD_SNAPSHOT);
+}
+
+/* @endcond */
+
+int ikTelemetryBoard_init(ikTelemetryBoard *self, const ikTelemetryBoardParams *params) {
+	ikTelemetryBoardHeader *header;
+	int i;
+	
+	self->memory.address = NULL;
+	
+	/* check the signal names */
+	if (0 > params->n || IKTELEMETRYBOARD_MAXSIGNALS < params->n) return -1;
+	for (i = 0; i < params->n; i++) {
+		if (IKTELEMETRYBOARD_MAXNAME <= strlen(params->names[i])) return -2;
+	}
+	self->n = params->n;
+	
+	/* create the shared memory, and publish the names */
+	if (ikSharedMemory_create(&(self->memory), params->name, IKTELEMETRYBOARD_SNAPSHOT + sizeof(ikTelemetryBoardSnapshot))) return -3;
+	header = ikTelemetryBoard_header(self);
+	for (i = 0; i < self->n; i++) {
+		strcpy(header->names[i], params->names[i]);
+	}
+	header->n = (unsigned int) self->n;
+	ikTelemetryBoard_snapshot(self)->sequence = 0;
+	header->version = IKTELEMETRYBOARD_VERSION;
+	ikSharedMemory_barrier();
+	header->magic = IKTELEMETRYBOARD_MAGIC;
+	
+	return 0;
+}
+
+void ikTelemetryBoard_initParams(ikTelemetryBoardParams *params) {
+	params->name = "OpenDisconTelemetry";
+	params->n = 0;
+}
+
+void ikTelemetryBoard_write(ikTelemetryBoard *self, unsigned long step, const double *values) {
+	ikTelemetryBoardSnapshot *snapshot;
+	
+	if (NULL == self->memory.address) return;
+	snapshot = ikTelemetryBoard_snapshot(self);
+	
+	/* odd sequence number while writing */
+	snapshot->sequence++;
+	ikSharedMemory_barrier();
+	snapshot->step = step;
+	memcpy(snapshot->values, values, self->n*sizeof(double));
+	ikSharedMemory_barrier();
+	snapshot->sequence++;
+}
+
+int ikTelemetryBoard_open(ikTelemetryBoard *self, const char *name) {
+	ikTelemetryBoardHeader *header;
+	
+	if (ikSharedMemory_open(&(self->memory), name)) return -1;
+	header = ikTelemetryBoard_header(self);
+	if (self->memory.size < IKTELEMETRYBOARD_SNAPSHOT + sizeof(ikTelemetryBoardSnapshot)
+			|| IKTELEMETRYBOARD_MAGIC != header->magic || IKTELEMETRYBOARD_VERSION != header->version
+			|| IKTELEMETRYBOARD_MAXSIGNALS < header->n) {
+		ikTelemetryBoard_close(self);
+		return -2;
+	}
+	self->n = (int) header->n;
+	
+	return 0;
+}
+
+int ikTelemetryBoard_getNumberOfSignals(const ikTelemetryBoard *self) {
+	return self->n;
+}
+
+const char *ikTelemetryBoard_getName(const ikTelemetryBoard *self, int i) {
+	if (0 > i || self->n <= i) return NULL;
+	return ikTelemetryBoard_header(self)->names[i];
+}
+
+int ikTelemetryBoard_read(const ikTelemetryBoard *self, unsigned long *step, double *values) {
+	ikTelemetryBoardSnapshot *snapshot;
+	unsigned int s1;
+	int i;
+	
+	if (NULL == self->memory.address) return -1;
+	snapshot = ikTelemetryBoard_snapshot(self);
+	
+	/* try to get a consistent copy of the snapshot */
+	for (i = 0; i < IKTELEMETRYBOARD_TRIES; i++) {
+		s1 = snapshot->sequence;
+		if (0 == s1) return 0;
+		if (s1 & 1u) continue;
+		ikSharedMemory_barrier();
+		*step = snapshot->step;
+		memcpy(values, snapshot->values, self->n*sizeof(double));
+		ikSharedMemory_barrier();
+		if (s1 == snapshot->sequence) return 1;
+	}
+	
+	return -1;
+}
+
+void ikTelemetryBoard_close(ikTelemetryBoard *self) {
+	ikSharedMemory_close(&(self->memory));
+}
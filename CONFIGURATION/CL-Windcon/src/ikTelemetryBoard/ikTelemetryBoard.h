@@ -0,0 +1,154 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikTelemetryBoard.h
+ * 
+ * @brief Class ikTelemetryBoard interface
+ */
+
+#ifndef IKTELEMETRYBOARD_H
+#define IKTELEMETRYBOARD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ikSharedMemory.h"
+
+#define IKTELEMETRYBOARD_MAXSIGNALS 64
+#define IKTELEMETRYBOARD_MAXNAME 128
+
+    /**
+     * @struct ikTelemetryBoard
+     * @brief Shared memory telemetry board
+     * 
+     * This is a named shared memory region holding the latest snapshot of a list of
+     * named signals, written by a controller and read by any number of monitoring tools.
+     * 
+     * The snapshot is guarded by a sequence lock: the writer makes the sequence number
+     * odd while it writes, and even again when done, and the readers copy the snapshot
+     * and try again if the sequence number was odd or has changed meanwhile. The writer
+     * never waits for the readers, and the readers never wait for the writer for longer
+     * than a few attempts.
+     * 
+     * @par Methods
+     * @li @link ikTelemetryBoard_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikTelemetryBoard_init @endlink initialise an instance, i.e. create the shared memory (writer side)
+     * @li @link ikTelemetryBoard_write @endlink write a snapshot (writer side)
+     * @li @link ikTelemetryBoard_open @endlink open an existing board (reader side)
+     * @li @link ikTelemetryBoard_getNumberOfSignals @endlink get the number of signals (reader side)
+     * @li @link ikTelemetryBoard_getName @endlink get the name of a signal (reader side)
+     * @li @link ikTelemetryBoard_read @endlink read the latest snapshot (reader side)
+     * @li @link ikTelemetryBoard_close @endlink close the shared memory
+     */
+    typedef struct ikTelemetryBoard {
+        /**
+         * Private members
+         */
+        /* @cond */
+        ikSharedMemory memory;
+        int n;
+        /* @endcond */
+    } ikTelemetryBoard;
+
+    /**
+     * @struct ikTelemetryBoardParams
+     * @brief Shared memory telemetry board initialisation parameters
+     */
+    typedef struct ikTelemetryBoardParams {
+        const char *name; /**<shared memory name. The default value is "OpenDisconTelemetry".*/
+        int n; /**<number of signals. The default value is 0.*/
+        const char *names[IKTELEMETRYBOARD_MAXSIGNALS]; /**<signal names*/
+    } ikTelemetryBoardParams;
+
+    /**
+     * Initialise an instance, by creating the shared memory
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of signals, must be between 0 and IKTELEMETRYBOARD_MAXSIGNALS
+     * @li -2: invalid signal name, must be shorter than IKTELEMETRYBOARD_MAXNAME characters
+     * @li -3: the shared memory cannot be created, e.g. because another board has the same name
+     */
+    int ikTelemetryBoard_init(ikTelemetryBoard *self, const ikTelemetryBoardParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikTelemetryBoard_initParams(ikTelemetryBoardParams *params);
+
+    /**
+     * Write a snapshot
+     * @param self instance
+     * @param step controller step number
+     * @param values signal values, in the order of the names
+     */
+    void ikTelemetryBoard_write(ikTelemetryBoard *self, unsigned long step, const double *values);
+
+    /**
+     * Open an existing board
+     * @param self instance
+     * @param name shared memory name
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the shared memory cannot be opened
+     * @li -2: the shared memory is not a telemetry board
+     */
+    int ikTelemetryBoard_open(ikTelemetryBoard *self, const char *name);
+
+    /**
+     * Get the number of signals
+     * @param self instance
+     * @return number of signals
+     */
+    int ikTelemetryBoard_getNumberOfSignals(const ikTelemetryBoard *self);
+
+    /**
+     * Get the name of a signal
+     * @param self instance
+     * @param i signal index
+     * @return signal name, or NULL if the index is invalid
+     */
+    const char *ikTelemetryBoard_getName(const ikTelemetryBoard *self, int i);
+
+    /**
+     * Read the latest snapshot, without waiting
+     * @param self instance
+     * @param step controller step number of the snapshot
+     * @param values signal values, as many as signals on the board
+     * @return state:
+     * @li 1: snapshot read
+     * @li 0: nothing written yet
+     * @li -1: no consistent snapshot, because the writer was busy; try again later
+     */
+    int ikTelemetryBoard_read(const ikTelemetryBoard *self, unsigned long *step, double *values);
+
+    /**
+     * Close the shared memory, and remove it if this instance created it
+     * @param self instance
+     */
+    void ikTelemetryBoard_close(ikTelemetryBoard *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKTELEMETRYBOARD_H */
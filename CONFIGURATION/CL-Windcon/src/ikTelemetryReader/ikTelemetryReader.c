@@ -0,0 +1,101 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ikTelemetryReader.c
+ *
+ * @brief Telemetry reader
+ *
+ * Attaches to a telemetry board and prints its snapshots as they change, one line
+ * per snapshot with the controller step number followed by the signal values, after
+ * a header line with the signal names. Usage:
+ * @code
+ * ikTelemetryReader [boardName [period]]
+ * @endcode
+ * where the period between reads is in ms, 100 by default.
+ */
+
+#ifndef _WIN32
+/* nanosleep */
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#include "ikTelemetryBoard.h"
+
+static void sleepFor(int period) {
+#ifdef _WIN32
+	Sleep(period);
+#else
+	struct timespec t;
+	
+	t.tv_sec = period/1000;
+	t.tv_nsec = (period%1000)*1000000L;
+	nanosleep(&t, NULL);
+#endif
+}
+
+int main(int argc, char *argv[]) {
+	ikTelemetryBoard board;
+	const char *name = "OpenDisconTelemetry";
+	int period = 100;
+	double values[IKTELEMETRYBOARD_MAXSIGNALS];
+	unsigned long step;
+	unsigned long lastStep = 0;
+	int n;
+	int i;
+	int err;
+	
+	if (1 < argc) name = argv[1];
+	if (2 < argc) period = atoi(argv[2]);
+	if (0 >= period) period = 100;
+	
+	err = ikTelemetryBoard_open(&board, name);
+	if (err) {
+		fprintf(stderr, "Cannot open telemetry board %s, error %d\n", name, err);
+		return 1;
+	}
+	
+	/* header */
+	n = ikTelemetryBoard_getNumberOfSignals(&board);
+	printf("step");
+	for (i = 0; i < n; i++) printf("\t%s", ikTelemetryBoard_getName(&board, i));
+	printf("\n");
+	fflush(stdout);
+	
+	/* snapshots, until interrupted */
+	for (;;) {
+		if (1 == ikTelemetryBoard_read(&board, &step, values) && step != lastStep) {
+			lastStep = step;
+			printf("%lu", step);
+			for (i = 0; i < n; i++) printf("\t%g", values[i]);
+			printf("\n");
+			fflush(stdout);
+		}
+		sleepFor(period);
+	}
+	
+	ikTelemetryBoard_close(&board);
+	return 0;
+}
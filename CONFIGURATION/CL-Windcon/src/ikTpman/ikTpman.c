@@ -40,6 +40,11 @@ int ikTpman_init(ikTpman *self, const ikTpmanParams *params) {
 void ikTpman_initParams(ikTpmanParams *params) {
 }
 
+void ikTpman_warmStart(ikTpman *self, double pitch, double minPitchExt) {
+    /* set state depending on the pitch angle */
+    self->state = pitch > minPitchExt ? 1 : 0;
+}
+
 int ikTpman_step(ikTpman *self, double torque, double maxTorque, double minTorqueExt, double pitch, double maxPitchExt, double minPitchExt) {
     /* save inputs */
     self->maxPitchExt = maxPitchExt;
@@ -114,6 +119,10 @@ int ikTpman_getOutput(const ikTpman *self, double *output, const char *name) {
         *output = self->maxTorque;
         return 0;
     }
+    if (!strcmp(name, "state")) {
+        *output = (double) self->state;
+        return 0;
+    }
 
     /* pick up the block names */
     sep = strstr(name, ">");
@@ -49,6 +49,7 @@ extern "C" {
      * @par Outputs
      * @li maximum pitch: upper pitch angle limit, in degrees, get via @link ikTpman_getOutput @endlink
      * @li minimum torque: lower torque limit for speed regulation, in kNm, get via @link ikTpman_getOutput @endlink
+     * @li state: 1 above rated, 0 below rated, get via @link ikTpman_getOutput @endlink
      * 
      * @par Unit block
      * 
@@ -65,6 +66,7 @@ extern "C" {
      * @par Methods
      * @li @link ikTpman_initParams @endlink initialise initialisation parameter structure
      * @li @link ikTpman_init @endlink initialise an instance
+     * @li @link ikTpman_warmStart @endlink set the initial state from the operating point
      * @li @link ikTpman_step @endlink execute periodic calculations
      * @li @link ikTpman_getOutput @endlink get output value
      */
@@ -111,6 +113,15 @@ extern "C" {
      */
     void ikTpman_initParams(ikTpmanParams *params);
     
+    /**
+     * Set the initial state from the operating point, i.e. above rated if the pitch
+     * angle is above its lower limit, and below rated otherwise
+     * @param self torque-pitch manager instance
+     * @param pitch pitch angle, in degrees
+     * @param minPitchExt externally imposed lower pitch angle limit, in degrees
+     */
+    void ikTpman_warmStart(ikTpman *self, double pitch, double minPitchExt);
+    
     /**
      * Execute periodic calculations
      * @param self torque-pitch manager instance
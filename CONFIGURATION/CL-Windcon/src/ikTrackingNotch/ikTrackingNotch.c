@@ -0,0 +1,177 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file ikTrackingNotch.c
+ * 
+ * @brief Class ikTrackingNotch implementation
+ */
+
+/* @cond */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "ikTrackingNotch.h"
+
+/* magnitude under which filter states are set to 0 */
+#define IKTRACKINGNOTCH_FLUSH 1.0e-30
+
+static void ikTrackingNotch_setFreq(ikTrackingNotch *self, double freq) {
+	double x;
+	double K;
+	double a0;
+	
+	/* prewarped bilinear transform constant, K = w/tan(w*T/2), using the
+	   [3/2] Pade approximant of the tangent, tan(x) ~ x*(15 - x^2)/(15 - 6*x^2),
+	   with a relative error below 1e-5 for x < 0.5 */
+	x = freq*self->T/2.0;
+	if (0.5 > x) K = 2.0/self->T * (15.0 - 6.0*x*x)/(15.0 - x*x);
+	else K = freq/tan(x);
+	
+	/*
+	bilinear transform of
+	        s^2 + 2*dnum*w*s + w^2
+	H(s) = ------------------------
+	        s^2 + 2*dden*w*s + w^2
+	*/
+	a0 = K*K + 2.0*self->dampDen*freq*K + freq*freq;
+	self->a[0] = 1.0;
+	self->a[1] = (2.0*freq*freq - 2.0*K*K)/a0;
+	self->a[2] = (K*K - 2.0*self->dampDen*freq*K + freq*freq)/a0;
+	self->b[0] = (K*K + 2.0*self->dampNum*freq*K + freq*freq)/a0;
+	self->b[1] = self->a[1];
+	self->b[2] = (K*K - 2.0*self->dampNum*freq*K + freq*freq)/a0;
+	
+	self->freq = freq;
+	self->nUpdates++;
+}
+
+/* follow the generator speed, updating the coefficients if the centre
+   frequency has moved enough */
+static void ikTrackingNotch_track(ikTrackingNotch *self, double generatorSpeed) {
+	double freq;
+	
+	freq = self->gain*fabs(generatorSpeed);
+	freq = freq > self->minFreq ? freq : self->minFreq;
+	freq = freq < self->maxFreq ? freq : self->maxFreq;
+	if (fabs(freq - self->freq) > self->tolerance*self->freq) ikTrackingNotch_setFreq(self, freq);
+}
+
+int ikTrackingNotch_init(ikTrackingNotch *self, const ikTrackingNotchParams *params) {
+	
+	/* register parameter values */
+	self->enable = params->enable;
+	if (0.0 >= params->T) return -1;
+	self->T = params->T;
+	if (0.0 >= params->gearboxRatio || 0.0 >= params->harmonic) return -2;
+	self->gain = params->harmonic/params->gearboxRatio;
+	if (0.0 >= params->minFreq || params->maxFreq <= params->minFreq || 3.14159265358979/params->T <= params->maxFreq) return -3;
+	self->minFreq = params->minFreq;
+	self->maxFreq = params->maxFreq;
+	if (0.0 > params->tolerance) return -4;
+	self->tolerance = params->tolerance;
+	self->dampNum = params->dampNum;
+	self->dampDen = params->dampDen;
+	
+	/* initialise coefficients at the lowest frequency, and states */
+	self->nUpdates = 0;
+	ikTrackingNotch_setFreq(self, self->minFreq);
+	self->state[0] = 0.0;
+	self->state[1] = 0.0;
+	self->input = 0.0;
+	self->output = 0.0;
+
+    return 0;
+}
+
+void ikTrackingNotch_initParams(ikTrackingNotchParams *params) {
+	params->enable = 0;
+	params->T = 0.01;
+	params->harmonic = 1.0;
+	params->gearboxRatio = 1.0;
+	params->dampNum = 0.01;
+	params->dampDen = 0.2;
+	params->tolerance = 0.01;
+	params->minFreq = 0.1;
+	params->maxFreq = 100.0;
+}
+
+void ikTrackingNotch_warmStart(ikTrackingNotch *self, double input, double generatorSpeed) {
+	/* register input and output, as the static gain is 1 */
+	self->input = input;
+	self->output = input;
+	if (!self->enable) return;
+	
+	/* set the coefficients for the generator speed */
+	ikTrackingNotch_track(self, generatorSpeed);
+	
+	/* set the states so that the output stays put */
+	self->state[1] = (self->b[2] - self->a[2])*input;
+	self->state[0] = (self->b[1] - self->a[1])*input + self->state[1];
+}
+
+double ikTrackingNotch_step(ikTrackingNotch *self, double input, double generatorSpeed) {
+	
+	/* register input */
+	self->input = input;
+	if (!self->enable) {
+		self->output = input;
+		return self->output;
+	}
+	
+	/* update the coefficients if the centre frequency has moved enough */
+	ikTrackingNotch_track(self, generatorSpeed);
+	
+	/* run the filter, transposed direct form II */
+	self->output = self->b[0]*input + self->state[0];
+	self->state[0] = self->b[1]*input - self->a[1]*self->output + self->state[1];
+	self->state[1] = self->b[2]*input - self->a[2]*self->output;
+	
+	/* flush decaying states before they become denormal */
+	if (fabs(self->state[0]) < IKTRACKINGNOTCH_FLUSH) self->state[0] = 0.0;
+	if (fabs(self->state[1]) < IKTRACKINGNOTCH_FLUSH) self->state[1] = 0.0;
+	
+	return self->output;
+}
+
+int ikTrackingNotch_getOutput(const ikTrackingNotch *self, double *output, const char *name) {
+	/* pick up the signal names */
+    if (!strcmp(name, "input")) {
+        *output = self->input;
+        return 0;
+    }
+    if (!strcmp(name, "output")) {
+        *output = self->output;
+        return 0;
+    }
+    if (!strcmp(name, "frequency")) {
+        *output = self->freq;
+        return 0;
+    }
+    if (!strcmp(name, "coefficient updates")) {
+        *output = self->nUpdates;
+        return 0;
+    }
+	
+	return -1;
+}
+
+/* @endcond */
@@ -0,0 +1,157 @@
+/*
+Copyright (C) 2017 IK4-IKERLAN
+
+This file is part of OpenDiscon.
+ 
+OpenDiscon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenDiscon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenDiscon. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file ikTrackingNotch.h
+ * 
+ * @brief Class ikTrackingNotch interface
+ */
+
+#ifndef IKTRACKINGNOTCH_H
+#define IKTRACKINGNOTCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    
+    /**
+     * @struct ikTrackingNotch
+     * @brief Rotor speed tracking notch filter
+     * 
+     * This is a notch filter whose centre frequency is a multiple (harmonic) of the
+     * rotor speed, e.g. 1P or 3P, with the following transfer function:
+     * @f[
+     *  H(s) = \frac{s^2 + 2 \xi_\mathrm{n} \omega s + \omega^2}{s^2 + 2 \xi_\mathrm{d} \omega s + \omega^2}
+     * @f]
+     * discretised by the bilinear transform, prewarped at the centre frequency.
+     * 
+     * The coefficients are only recalculated when the centre frequency has moved by more than
+     * a given relative tolerance since the last recalculation, and the prewarping tangent is
+     * approximated by a rational function, so tracking the rotor speed costs little more than
+     * running a fixed notch.
+     * 
+     * @par Inputs
+     * @li input: signal to be filtered, specify via @link ikTrackingNotch_step @endlink
+     * @li generator speed: generator speed, in rad/s, from which the centre frequency is calculated, specify via @link ikTrackingNotch_step @endlink
+     * 
+     * @par Outputs
+     * @li output: filtered signal, returned by @link ikTrackingNotch_step @endlink, alternatively get via @link ikTrackingNotch_getOutput @endlink
+     * @li frequency: centre frequency used for the current coefficients, in rad/s, get via @link ikTrackingNotch_getOutput @endlink
+     * @li coefficient updates: number of coefficient recalculations so far, get via @link ikTrackingNotch_getOutput @endlink
+     * 
+     * @par Methods
+     * @li @link ikTrackingNotch_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikTrackingNotch_init @endlink initialise an instance
+     * @li @link ikTrackingNotch_warmStart @endlink set the initial state for a constant input
+     * @li @link ikTrackingNotch_step @endlink execute periodic calculations
+     * @li @link ikTrackingNotch_getOutput @endlink get output value
+     */
+    typedef struct ikTrackingNotch {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int enable;
+        double T;
+        double gain;
+        double dampNum;
+        double dampDen;
+        double tolerance;
+        double minFreq;
+        double maxFreq;
+        double freq;
+        double b[3];
+        double a[3];
+        double state[2];
+        double input;
+        double output;
+        int nUpdates;
+        /* @endcond */
+    } ikTrackingNotch;
+    
+    /**
+     * @struct ikTrackingNotchParams
+     * @brief Rotor speed tracking notch filter initialisation parameters
+     */
+    typedef struct ikTrackingNotchParams {
+        int enable; /**<enable flag, the input is passed through when 0. The default value is 0*/
+        double T; /**<sampling interval, in s. The default value is 0.01*/
+        double harmonic; /**<centre frequency as a multiple of the rotor speed, e.g. 1 for 1P or 3 for 3P. The default value is 1.0*/
+        double gearboxRatio; /**<gearbox ratio, dimensionless. The default value is 1.0*/
+        double dampNum; /**<numerator damping factor, dimensionless. The default value is 0.01*/
+        double dampDen; /**<denominator damping factor, dimensionless. The default value is 0.2*/
+        double tolerance; /**<relative change in centre frequency which triggers a coefficient recalculation, dimensionless. The default value is 0.01*/
+        double minFreq; /**<lower centre frequency limit, in rad/s. The default value is 0.1*/
+        double maxFreq; /**<upper centre frequency limit, in rad/s, below the Nyquist frequency. The default value is 100.0*/
+    } ikTrackingNotchParams;
+    
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid sampling interval, must be positive
+     * @li -2: invalid gearbox ratio or harmonic, must be positive
+     * @li -3: invalid centre frequency limits, must be positive, increasing and below the Nyquist frequency
+     * @li -4: invalid tolerance, must be non-negative
+     */
+    int ikTrackingNotch_init(ikTrackingNotch *self, const ikTrackingNotchParams *params);
+    
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikTrackingNotch_initParams(ikTrackingNotchParams *params);
+
+    /**
+     * Set the initial state to the steady state for a constant input
+     * @param self instance
+     * @param input input value
+     * @param generatorSpeed generator speed, in rad/s
+     */
+    void ikTrackingNotch_warmStart(ikTrackingNotch *self, double input, double generatorSpeed);
+    
+    /**
+     * Execute periodic calculations
+     * @param self instance
+     * @param input signal to be filtered
+     * @param generatorSpeed generator speed, in rad/s
+     * @return filtered signal
+     */
+    double ikTrackingNotch_step(ikTrackingNotch *self, double input, double generatorSpeed);
+    
+    /**
+     * Get output value by name. All signals named in the description of
+     * @link ikTrackingNotch @endlink are accessible.
+     * @param self instance
+     * @param output output value
+     * @param name output name
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid signal name
+     */
+    int ikTrackingNotch_getOutput(const ikTrackingNotch *self, double *output, const char *name);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKTRACKINGNOTCH_H */
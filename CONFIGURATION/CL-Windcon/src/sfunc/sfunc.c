@@ -1135,7 +1135,11 @@ static void mdlInitializeSampleTimes(SimStruct *S)
 	/* Initialise controller */
 	ikClwindconWTConParams param;
 	ikClwindconWTCon_initParams(&param);
-	setParams(&param);
+	/* tune for the block sample time, if it is discrete */
+	if (0.0 < ssGetSampleTime(S, 0)) setParamsForInterval(&param, ssGetSampleTime(S, 0));
+	else setParams(&param);
+	/* free what a previous initialisation allocated, if any */
+	ikClwindconWTCon_close(con);
 	ikClwindconWTCon_init(con, &param);
   }
 #endif /* MDL_INITIALIZE_CONDITIONS */
@@ -1317,6 +1321,7 @@ static void mdlTerminate(SimStruct *S)
 	/* free the memory allocated in mdlStart */
 	if (ssGetPWork(S) != NULL) {
 		void *ptr = ssGetPWorkValue(S,0);
+		if (ptr != NULL) ikClwindconWTCon_close((ikClwindconWTCon *) ptr);
 		if (ptr != NULL) free(ptr);
 	}
 }